@@ -1,3 +1,12 @@
 #! /usr/bin/env bash
-$XGETTEXT `find src/daemon -name '*.cpp'` -o $podir/notificationhelper.pot
+# Display names of the shipped restricted package catalog, package/context
+# entries become the context of the package's name.
+awk 'NR == FNR { if (match($0, /^[^#[=]*\/context=/)) ctx[substr($0, 1, RLENGTH - 9)] = substr($0, RLENGTH + 1); next }
+     /^[#[]/ { next }
+     { eq = index($0, "="); key = substr($0, 1, eq - 1) }
+     eq == 0 || key ~ /[\/[]/ { next }
+     key in ctx { printf "i18nc(\"%s\", \"%s\");\n", ctx[key], substr($0, eq + 1); next }
+     { printf "i18n(\"%s\");\n", substr($0, eq + 1) }' data/restricted-packages data/restricted-packages > rc.cpp
+$XGETTEXT rc.cpp `find src/daemon -name '*.cpp'` -o $podir/notificationhelper.pot
+rm -f rc.cpp
 $XGETTEXT `find src/kcmodule -name '*.cpp'` -o $podir/kcm_notificationhelper.pot
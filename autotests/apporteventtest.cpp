@@ -0,0 +1,173 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+// Drives ApportEvent's per-file handling on a sandbox crash directory. File
+// events are handed in directly so the test does not depend on inotify
+// timing.
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QtTest>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+#include "../src/daemon/apportevent/apportevent.h"
+
+class ApportEventTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void crashCounting();
+    void stamps();
+    void uploaded();
+
+private:
+    QString write(const QString &name, const QByteArray &data, QIODevice::OpenMode mode = QIODevice::WriteOnly);
+    static QByteArray report(const QByteArray &date);
+
+    QTemporaryDir *m_dir;
+    QString m_stem;
+    ApportEvent *m_event;
+};
+
+QByteArray ApportEventTest::report(const QByteArray &date)
+{
+    return "ProblemType: Crash\n"
+           "Date: " + date + "\n"
+           "ExecutablePath: /usr/bin/kate\n";
+}
+
+QString ApportEventTest::write(const QString &name, const QByteArray &data, QIODevice::OpenMode mode)
+{
+    const QString path = m_dir->path() + QLatin1Char('/') + name;
+    QFile file(path);
+    if (!file.open(mode) || file.write(data) != data.size()) {
+        qFatal("failed to write %s", qPrintable(path));
+    }
+    return path;
+}
+
+void ApportEventTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    // Keep notifications out of the way, file handling happens regardless.
+    KConfig cfg("notificationhelper");
+    KConfigGroup eventGroup(&cfg, "Event");
+    eventGroup.writeEntry("hideApportNotifier", true);
+}
+
+void ApportEventTest::init()
+{
+    m_dir = new QTemporaryDir;
+    QVERIFY(m_dir->isValid());
+    m_stem = m_dir->path() + QLatin1String("/_usr_bin_kate.1000");
+    m_event = new ApportEvent(nullptr, m_dir->path());
+    QVERIFY(m_event->isHidden());
+}
+
+void ApportEventTest::cleanup()
+{
+    m_event->m_uploadRunning = false;
+    delete m_event;
+    delete m_dir;
+}
+
+void ApportEventTest::crashCounting()
+{
+    const QString path = write("_usr_bin_kate.1000.crash", report("Tue Oct 13 12:00:00 2026"));
+    // Reports are looked at once written, not when created.
+    m_event->onFileChanged(path, FileWatcher::Created);
+    QCOMPARE(m_event->m_burst.crashCount(), 0);
+    m_event->onFileChanged(path, FileWatcher::ClosedWrite);
+    QCOMPARE(m_event->m_burst.crashCount(), 1);
+    QCOMPARE(m_event->m_states.value(m_stem), CrashFile::State(CrashFile::Crash));
+
+    // whoopsie-upload-all and the apport UI append collected info.
+    write("_usr_bin_kate.1000.crash", "Dependencies: kate 1.0\n", QIODevice::Append);
+    m_event->onFileChanged(path, FileWatcher::ClosedWrite);
+    QCOMPARE(m_event->m_burst.crashCount(), 1);
+
+    // Rewritten through a new file, still the same crash.
+    const QString temp = write("report.tmp", report("Tue Oct 13 12:00:00 2026"));
+    QFile::remove(path);
+    QVERIFY(QFile::rename(temp, path));
+    m_event->onFileChanged(path, FileWatcher::MovedIn);
+    QCOMPARE(m_event->m_burst.crashCount(), 1);
+
+    // Another crash replaces the report.
+    QFile::remove(path);
+    m_event->onFileChanged(path, FileWatcher::Deleted);
+    write("_usr_bin_kate.1000.crash", report("Tue Oct 13 12:05:00 2026"));
+    m_event->onFileChanged(path, FileWatcher::ClosedWrite);
+    QCOMPARE(m_event->m_burst.crashCount(), 2);
+    QCOMPARE(m_event->m_burst.suppressedCount(), 1);
+}
+
+void ApportEventTest::stamps()
+{
+    const QString crash = write("_usr_bin_kate.1000.crash", report("Tue Oct 13 12:00:00 2026"));
+    m_event->onFileChanged(crash, FileWatcher::ClosedWrite);
+    const QString upload = write("_usr_bin_kate.1000.upload", QByteArray());
+    m_event->onFileChanged(upload, FileWatcher::Created);
+    QCOMPARE(m_event->m_states.value(m_stem), CrashFile::Crash | CrashFile::Upload);
+    // The state before the first unevaluated change is kept.
+    QCOMPARE(m_event->m_before.value(m_stem), CrashFile::State());
+
+    QFile::remove(crash);
+    m_event->onFileChanged(crash, FileWatcher::Deleted);
+    QCOMPARE(m_event->m_states.value(m_stem), CrashFile::State(CrashFile::Upload));
+    QFile::remove(upload);
+    m_event->onFileChanged(upload, FileWatcher::Deleted);
+    QVERIFY(!m_event->m_states.contains(m_stem));
+
+    // Unrelated files and other directories are ignored.
+    m_event->onFileChanged(write("notes.txt", "hi"), FileWatcher::ClosedWrite);
+    m_event->onFileChanged(QStringLiteral("/var/crash/_usr_bin_kate.1000.crash"), FileWatcher::ClosedWrite);
+    QVERIFY(m_event->m_states.isEmpty());
+    QCOMPARE(m_event->m_burst.crashCount(), 1);
+}
+
+void ApportEventTest::uploaded()
+{
+    // Pretend an upload job is running.
+    m_event->m_uploadRunning = true;
+    const QString path = write("_usr_bin_kate.1000.uploaded", QByteArray());
+    m_event->onFileChanged(path, FileWatcher::Created);
+    m_event->onFileChanged(path, FileWatcher::ClosedWrite);
+    QCOMPARE(m_event->m_uploadedCount, 1);
+    QCOMPARE(m_event->m_states.value(m_stem), CrashFile::State(CrashFile::Uploaded));
+}
+
+QTEST_GUILESS_MAIN(ApportEventTest);
+
+#include "apporteventtest.moc"
@@ -0,0 +1,246 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+// Scale benchmark for the crash detection path. Sandbox crash directories
+// with up to 50,000 reports in mixed stamp states are generated up front.
+// For machine-readable results run e.g.:
+//   crashbenchmark -o crashbenchmark.xml,xml
+//   crashbenchmark -o crashbenchmark.csv,csv
+
+#include <QObject>
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "../src/daemon/apportevent/crashburst.h"
+#include "../src/daemon/apportevent/crashfile.h"
+#include "../src/daemon/apportevent/crashheader.h"
+#include "../src/daemon/apportevent/crashreports.h"
+
+class CrashBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+
+    void scan_data();
+    void scan();
+    void newReports_data();
+    void newReports();
+    void dirtyFile_data();
+    void dirtyFile();
+    void burst_data();
+    void burst();
+
+private:
+    void addSizes();
+    QString directory(int reports);
+
+    QTemporaryDir m_root;
+    QHash<int, QString> m_directories;
+};
+
+static QString stemFor(int i)
+{
+    return QStringLiteral("_usr_bin_app%1.1000").arg(i);
+}
+
+static void touch(const QString &path, const QByteArray &content = QByteArray())
+{
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        qFatal("failed to create %s", qPrintable(path));
+    }
+    file.write(content);
+}
+
+// Reports cycle through: new, marked for upload, uploaded, accepted and
+// orphaned stamps without report.
+QString CrashBenchmark::directory(int reports)
+{
+    if (m_directories.contains(reports)) {
+        return m_directories.value(reports);
+    }
+
+    const QString dir = m_root.path() + QLatin1Char('/') + QString::number(reports);
+    QDir().mkpath(dir);
+    for (int i = 0; i < reports; ++i) {
+        const QString stem = dir + QLatin1Char('/') + stemFor(i);
+        switch (i % 5) {
+        case 0:
+            touch(stem + QLatin1String(".crash"), "ProblemType: Crash\n");
+            break;
+        case 1:
+            touch(stem + QLatin1String(".crash"), "ProblemType: Crash\n");
+            touch(stem + QLatin1String(".upload"));
+            break;
+        case 2:
+            touch(stem + QLatin1String(".crash"), "ProblemType: Crash\n");
+            touch(stem + QLatin1String(".upload"));
+            touch(stem + QLatin1String(".uploaded"));
+            break;
+        case 3:
+            touch(stem + QLatin1String(".crash"), "ProblemType: Crash\n");
+            touch(stem + QLatin1String(".drkonqi-accept"));
+            break;
+        default:
+            touch(stem + QLatin1String(".uploaded"));
+            break;
+        }
+    }
+
+    m_directories.insert(reports, dir);
+    return dir;
+}
+
+void CrashBenchmark::initTestCase()
+{
+    QVERIFY(m_root.isValid());
+}
+
+void CrashBenchmark::addSizes()
+{
+    QTest::addColumn<int>("reports");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("50000") << 50000;
+}
+
+void CrashBenchmark::scan_data()
+{
+    addSizes();
+}
+
+// Full-directory classification as done on overflow/rescan.
+void CrashBenchmark::scan()
+{
+    QFETCH(int, reports);
+    const QString dir = directory(reports);
+
+    int valid = 0;
+    int accepted = 0;
+    QBENCHMARK {
+        valid = 0;
+        accepted = 0;
+        const CrashFile::StateMap states = CrashFile::scan(dir);
+        for (auto it = states.constBegin(); it != states.constEnd(); ++it) {
+            const CrashFile f(it.key() + QLatin1String(".crash"), it.value());
+            if (f.isAutoUploadAllowed()) {
+                ++accepted;
+            } else if (f.isValid()) {
+                ++valid;
+            }
+        }
+    }
+    QCOMPARE(valid, (reports + 4) / 5);
+    QCOMPARE(accepted, (reports + 1) / 5);
+}
+
+void CrashBenchmark::newReports_data()
+{
+    addSizes();
+}
+
+// The check backing the notification, stats every candidate report.
+void CrashBenchmark::newReports()
+{
+    QFETCH(int, reports);
+    const QString dir = directory(reports);
+    CrashReports crashReports(dir, dir + QLatin1String("/no-apport-config"));
+
+    QStringList result;
+    QBENCHMARK {
+        result = crashReports.newReports();
+    }
+    // New and accepted reports are not marked for upload.
+    QCOMPARE(result.size(), (reports + 4) / 5 + (reports + 1) / 5);
+}
+
+void CrashBenchmark::dirtyFile_data()
+{
+    addSizes();
+}
+
+// What ApportEvent does for a single written report: classify the path,
+// update the known state and read the report's headers. Must not depend
+// on the directory size.
+void CrashBenchmark::dirtyFile()
+{
+    QFETCH(int, reports);
+    const QString dir = directory(reports);
+    const QString path = dir + QLatin1Char('/') + stemFor(reports - 2) + QLatin1String(".crash");
+    CrashFile::StateMap states = CrashFile::scan(dir);
+
+    bool valid = false;
+    CrashHeader header;
+    QBENCHMARK {
+        QString stem;
+        const CrashFile::StateFlag flag = CrashFile::classify(path, &stem);
+        CrashFile::State &state = states[stem];
+        state |= flag;
+        valid = CrashFile(path, state).isValid() || CrashFile(path, state).isAutoUploadAllowed();
+        header = CrashHeader::read(path);
+    }
+    QVERIFY(valid);
+    QVERIFY(header.isValid());
+}
+
+void CrashBenchmark::burst_data()
+{
+    QTest::addColumn<int>("crashes");
+    QTest::addColumn<int>("executables");
+
+    QTest::newRow("1000x1") << 1000 << 1;
+    QTest::newRow("10000x10") << 10000 << 10;
+    QTest::newRow("50000x1000") << 50000 << 1000;
+}
+
+// Crash loop dedupe.
+void CrashBenchmark::burst()
+{
+    QFETCH(int, crashes);
+    QFETCH(int, executables);
+
+    QStringList stems;
+    for (int i = 0; i < executables; ++i) {
+        stems << QStringLiteral("/var/crash/") + stemFor(i);
+    }
+
+    CrashBurst burst(60 * 1000);
+    int surfaced = 0;
+    QBENCHMARK {
+        burst.reset();
+        surfaced = 0;
+        for (int i = 0; i < crashes; ++i) {
+            const QString executable = CrashBurst::executableForStem(stems.at(i % executables));
+            if (burst.record(executable, i)) {
+                ++surfaced;
+            }
+        }
+    }
+    QCOMPARE(surfaced, executables);
+    QCOMPARE(burst.crashCount(), crashes);
+    QCOMPARE(burst.suppressedCount(), crashes - executables);
+}
+
+QTEST_GUILESS_MAIN(CrashBenchmark);
+
+#include "crashbenchmark.moc"
@@ -0,0 +1,168 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <QObject>
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "../src/daemon/apportevent/crashheader.h"
+
+static const char s_report[] =
+    "ProblemType: Crash\n"
+    "Architecture: amd64\n"
+    "Date: Tue Oct 13 12:00:00 2026\n"
+    "DistroRelease: Ubuntu 26.10\n"
+    "ExecutablePath: /usr/bin/kate\n"
+    "ExecutableTimestamp: 1600000000\n"
+    "Package: kate 4:26.08.0-0ubuntu1\n"
+    "ProcCmdline: kate\n"
+    "ProcEnviron:\n"
+    " LANG=en_US.UTF-8\n"
+    " SHELL=/bin/bash\n";
+
+class CrashHeaderTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void parse();
+    void binaryStops();
+    void hugeReport();
+    void longTextFields();
+    void packageProblem();
+    void notAReport();
+};
+
+void CrashHeaderTest::parse()
+{
+    const CrashHeader header = CrashHeader::parse(s_report, sizeof(s_report) - 1);
+    QVERIFY(header.isValid());
+    QCOMPARE(header.problemType, QStringLiteral("Crash"));
+    QCOMPARE(header.executablePath, QStringLiteral("/usr/bin/kate"));
+    QCOMPARE(header.package, QStringLiteral("kate 4:26.08.0-0ubuntu1"));
+    QCOMPARE(header.date, QStringLiteral("Tue Oct 13 12:00:00 2026"));
+    QCOMPARE(header.applicationName(), QStringLiteral("kate"));
+}
+
+void CrashHeaderTest::binaryStops()
+{
+    const QByteArray report = QByteArray("ProblemType: Crash\n"
+                                         "CoreDump: base64\n"
+                                         " H4sICAAAAAAC/0NvcmVEdW1wAA==\n"
+                                         "Package: never reached\n");
+    const CrashHeader header = CrashHeader::parse(report.constData(), report.size());
+    QCOMPARE(header.problemType, QStringLiteral("Crash"));
+    QVERIFY(header.package.isEmpty());
+    QCOMPARE(header.applicationName(), QString());
+}
+
+void CrashHeaderTest::hugeReport()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path() + QLatin1String("/_usr_bin_kate.1000.crash");
+    QFile file(path);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(s_report);
+    file.write("CoreDump: base64\n");
+    const QByteArray blob(1024 * 1024, 'A');
+    for (int i = 0; i < 64; ++i) { // 64 MiB core dump
+        file.write(" ");
+        file.write(blob);
+        file.write("\n");
+    }
+    file.close();
+
+    const CrashHeader header = CrashHeader::read(path);
+    QCOMPARE(header.executablePath, QStringLiteral("/usr/bin/kate"));
+    QCOMPARE(header.applicationName(), QStringLiteral("kate"));
+
+    // Headers beyond the limit are scanned for, the core dump is not.
+    const CrashHeader truncated = CrashHeader::read(path, 40);
+    QCOMPARE(truncated.problemType, QStringLiteral("Crash"));
+    QCOMPARE(truncated.executablePath, QStringLiteral("/usr/bin/kate"));
+    QCOMPARE(truncated.package, QStringLiteral("kate 4:26.08.0-0ubuntu1"));
+}
+
+void CrashHeaderTest::longTextFields()
+{
+    // No core dump, but text fields sorting before ExecutablePath push it
+    // far beyond the mapped limit.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path() + QLatin1String("/_usr_bin_kate.1000.crash");
+    QFile file(path);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("ProblemType: Crash\n"
+               "Date: Tue Oct 13 12:00:00 2026\n"
+               "Dependencies:\n");
+    for (int i = 0; i < 5000; ++i) {
+        file.write(" libfoo" + QByteArray::number(i) + " 1.0-1\n");
+    }
+    file.write("Disassembly: " + QByteArray(64 * 1024, 'x') + "\n"); // overlong line
+    file.write("ExecutablePath: /usr/bin/kate\n"
+               "Package: kate 4:26.08.0-0ubuntu1\n");
+    file.close();
+    QVERIFY(file.size() > 16 * 1024);
+
+    const CrashHeader header = CrashHeader::read(path);
+    QCOMPARE(header.date, QStringLiteral("Tue Oct 13 12:00:00 2026"));
+    QCOMPARE(header.executablePath, QStringLiteral("/usr/bin/kate"));
+    QCOMPARE(header.package, QStringLiteral("kate 4:26.08.0-0ubuntu1"));
+
+    // The scan past the mapping is capped.
+    const CrashHeader capped = CrashHeader::read(path, 16 * 1024, 32 * 1024);
+    QCOMPARE(capped.date, QStringLiteral("Tue Oct 13 12:00:00 2026"));
+    QVERIFY(capped.executablePath.isNull());
+
+    // Within the mapped data parsing tells where it had to stop.
+    QByteArray data("ProblemType: Crash\nDependencies:\n libfoo 1.0");
+    qint64 consumed = 0;
+    CrashHeader::parse(data.constData(), data.size(), &consumed);
+    QCOMPARE(consumed, qint64(data.indexOf(" libfoo")));
+    // All fields found.
+    CrashHeader::parse(s_report, sizeof(s_report) - 1, &consumed);
+    QCOMPARE(consumed, qint64(-1));
+}
+
+void CrashHeaderTest::packageProblem()
+{
+    // No executable for package problems, parsing stops with the package.
+    const QByteArray report("ProblemType: Package\n"
+                            "Date: Tue Oct 13 12:00:00 2026\n"
+                            "Package: grub-efi 2.06-2ubuntu7\n"
+                            "ExecutablePath: /not/looked/at\n");
+    qint64 consumed = 0;
+    const CrashHeader header = CrashHeader::parse(report.constData(), report.size(), &consumed);
+    QCOMPARE(consumed, qint64(-1));
+    QCOMPARE(header.package, QStringLiteral("grub-efi 2.06-2ubuntu7"));
+    QVERIFY(header.executablePath.isNull());
+    QCOMPARE(header.applicationName(), QStringLiteral("grub-efi"));
+}
+
+void CrashHeaderTest::notAReport()
+{
+    const QByteArray garbage("\x7f" "ELF\x02\x01\x01\n\0\0", 10);
+    QVERIFY(!CrashHeader::parse(garbage.constData(), garbage.size()).isValid());
+    QVERIFY(!CrashHeader::read(QStringLiteral("/does/not/exist")).isValid());
+}
+
+QTEST_GUILESS_MAIN(CrashHeaderTest);
+
+#include "crashheadertest.moc"
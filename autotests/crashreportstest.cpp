@@ -0,0 +1,228 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <QObject>
+#include <QProcess>
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "../src/daemon/apportevent/crashfile.h"
+#include "../src/daemon/apportevent/crashreports.h"
+
+static const char s_checkReports[] = "/usr/share/apport/apport-checkreports";
+
+class CrashReportsTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void newReports_data();
+    void newReports();
+    void unreadable();
+    void scanUnreadable();
+    void disabled();
+
+private:
+    // Creates @p name in @p dir. seen files get an atime after their mtime
+    // just like apport leaves them after having shown them.
+    static void touch(const QString &dir, const QString &name,
+                      const QByteArray &content = "ProblemType: Crash\n", bool seen = false);
+};
+
+void CrashReportsTest::touch(const QString &dir, const QString &name,
+                             const QByteArray &content, bool seen)
+{
+    const QString path = dir + QLatin1Char('/') + name;
+    QFile file(path);
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write(content);
+    file.close();
+
+    struct utimbuf times;
+    times.modtime = 1000000000;
+    times.actime = seen ? times.modtime + 60 : times.modtime - 60;
+    QCOMPARE(utime(QFile::encodeName(path).constData(), &times), 0);
+}
+
+void CrashReportsTest::newReports_data()
+{
+    // Fixture directory layout: file names with attributes, expected new
+    // reports (by file name).
+    QTest::addColumn<QStringList>("crashes");
+    QTest::addColumn<QStringList>("seen");
+    QTest::addColumn<QStringList>("empty");
+    QTest::addColumn<QStringList>("stamps");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("empty dir")
+        << QStringList() << QStringList() << QStringList() << QStringList()
+        << QStringList();
+    QTest::newRow("single new")
+        << (QStringList() << "_usr_bin_foo.1000.crash")
+        << QStringList() << QStringList() << QStringList()
+        << (QStringList() << "_usr_bin_foo.1000.crash");
+    QTest::newRow("seen")
+        << QStringList()
+        << (QStringList() << "_usr_bin_foo.1000.crash")
+        << QStringList() << QStringList()
+        << QStringList();
+    QTest::newRow("empty file")
+        << QStringList() << QStringList()
+        << (QStringList() << "_usr_bin_foo.1000.crash")
+        << QStringList()
+        << QStringList();
+    QTest::newRow("wrong suffix")
+        << (QStringList() << "_usr_bin_foo.1000.crash.bak" << "_usr_bin_foo.1000.txt")
+        << QStringList() << QStringList() << QStringList()
+        << QStringList();
+    QTest::newRow("upload stamp")
+        << (QStringList() << "_usr_bin_foo.1000.crash" << "_usr_bin_bar.1000.crash")
+        << QStringList() << QStringList()
+        << (QStringList() << "_usr_bin_foo.1000.upload")
+        << (QStringList() << "_usr_bin_bar.1000.crash");
+    QTest::newRow("uploaded stamp")
+        << (QStringList() << "_usr_bin_foo.1000.crash")
+        << QStringList() << QStringList()
+        << (QStringList() << "_usr_bin_foo.1000.upload" << "_usr_bin_foo.1000.uploaded")
+        << QStringList();
+    QTest::newRow("accept stamp is no upload")
+        << (QStringList() << "_usr_bin_foo.1000.crash")
+        << QStringList() << QStringList()
+        << (QStringList() << "_usr_bin_foo.1000.drkonqi-accept")
+        << (QStringList() << "_usr_bin_foo.1000.crash");
+    QTest::newRow("mixed")
+        << (QStringList() << "_usr_bin_a.1000.crash" << "_usr_bin_b.1000.crash" << "_usr_bin_c.1000.crash")
+        << (QStringList() << "_usr_bin_d.1000.crash")
+        << (QStringList() << "_usr_bin_e.1000.crash")
+        << (QStringList() << "_usr_bin_b.1000.uploaded")
+        << (QStringList() << "_usr_bin_a.1000.crash" << "_usr_bin_c.1000.crash");
+}
+
+void CrashReportsTest::newReports()
+{
+    QFETCH(QStringList, crashes);
+    QFETCH(QStringList, seen);
+    QFETCH(QStringList, empty);
+    QFETCH(QStringList, stamps);
+    QFETCH(QStringList, expected);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    foreach (const QString &name, crashes) {
+        touch(dir.path(), name);
+    }
+    foreach (const QString &name, seen) {
+        touch(dir.path(), name, "ProblemType: Crash\n", true);
+    }
+    foreach (const QString &name, empty) {
+        touch(dir.path(), name, QByteArray());
+    }
+    foreach (const QString &name, stamps) {
+        touch(dir.path(), name, QByteArray());
+    }
+
+    QStringList expectedPaths;
+    foreach (const QString &name, expected) {
+        expectedPaths << QDir(dir.path()).absoluteFilePath(name);
+    }
+
+    const QString noConfig = dir.path() + QLatin1String("/no-apport-config");
+    CrashReports reports(dir.path(), noConfig);
+    QCOMPARE(reports.newReports(), expectedPaths);
+    QCOMPARE(reports.reportsAvailable(), !expectedPaths.isEmpty());
+
+    // Compatibility with the real thing, it honors APPORT_REPORT_DIR.
+    if (!QFile::exists(QLatin1String(s_checkReports))) {
+        QSKIP("apport-checkreports not installed, skipping compatibility check");
+    }
+    QProcess checkReports;
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    env.insert(QStringLiteral("APPORT_REPORT_DIR"), dir.path());
+    checkReports.setProcessEnvironment(env);
+    checkReports.start(QLatin1String(s_checkReports));
+    QVERIFY(checkReports.waitForFinished());
+    CrashReports system(dir.path());
+    QCOMPARE(checkReports.exitCode() == 0, system.reportsAvailable());
+}
+
+void CrashReportsTest::unreadable()
+{
+    if (::getuid() == 0) {
+        QSKIP("root can read anything");
+    }
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    touch(dir.path(), QStringLiteral("_usr_bin_foo.0.crash"));
+    const QString path = dir.path() + QLatin1String("/_usr_bin_foo.0.crash");
+    QCOMPARE(chmod(QFile::encodeName(path).constData(), 0), 0);
+
+    CrashReports reports(dir.path(), dir.path() + QLatin1String("/no-apport-config"));
+    QVERIFY(reports.newReports().isEmpty());
+}
+
+void CrashReportsTest::scanUnreadable()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    touch(dir.path(), QStringLiteral("_usr_bin_foo.1000.crash"));
+    touch(dir.path(), QStringLiteral("_usr_bin_foo.1000.upload"), QByteArray());
+    const QString stem = dir.path() + QLatin1String("/_usr_bin_foo.1000");
+    QCOMPARE(chmod(QFile::encodeName(stem + QLatin1String(".crash")).constData(), 0), 0);
+
+    // Checked by permission bits, so this holds for root as well.
+    QHash<QString, quint64> inodes;
+    const CrashFile::StateMap states = CrashFile::scan(dir.path(), &inodes);
+    QCOMPARE(states.value(stem), CrashFile::State(CrashFile::Upload));
+    QVERIFY(!inodes.contains(stem));
+    QCOMPARE(CrashFile::classify(stem + QLatin1String(".crash"), nullptr), CrashFile::Crash);
+    QVERIFY(!CrashFile::isReadable(stem + QLatin1String(".crash")));
+}
+
+void CrashReportsTest::disabled()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    touch(dir.path(), QStringLiteral("_usr_bin_foo.1000.crash"));
+
+    const QString config = dir.path() + QLatin1String("/apport");
+    QFile file(config);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("# set this to 0 to disable apport\n enabled = 0 \n");
+    file.close();
+
+    CrashReports reports(dir.path(), config);
+    QVERIFY(!reports.isApportEnabled());
+    QCOMPARE(reports.newReports().size(), 1);
+    QVERIFY(!reports.reportsAvailable());
+
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write("enabled=1\n");
+    file.close();
+    QVERIFY(reports.isApportEnabled());
+    QVERIFY(reports.reportsAvailable());
+}
+
+QTEST_GUILESS_MAIN(CrashReportsTest);
+
+#include "crashreportstest.moc"
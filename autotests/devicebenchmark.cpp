@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+// Benchmark for demarshalling DriverManager's devices() reply. The reply is
+// generated, sent over a peer-to-peer DBus connection within the process
+// and demarshalled repeatedly, e.g.:
+//   devicebenchmark -o devicebenchmark.csv,csv
+
+#include <QObject>
+#include <QtTest>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusServer>
+
+#include "../src/daemon/driverevent/Device.h"
+#include "fakedrivermanager.h"
+
+class DeviceBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+
+    void demarshall_data();
+    void demarshall();
+
+private:
+    QDBusServer *m_server;
+    // Server side connections, closed once the last copy is gone.
+    QList<QDBusConnection> m_connections;
+    FakeDriverManager m_manager;
+};
+
+void DeviceBenchmark::initTestCase()
+{
+    FakeDriverManager::registerTypes();
+    qDBusRegisterMetaType<DeviceList>();
+
+    // No bus daemon needed, the server side lives in this process.
+    m_server = new QDBusServer(this);
+    QVERIFY(m_server->isConnected());
+    connect(m_server, &QDBusServer::newConnection, this, [this](const QDBusConnection &connection) {
+        m_connections << connection;
+        m_connections.last().registerObject("/DriverManager", &m_manager,
+                                            QDBusConnection::ExportAllSlots);
+    });
+}
+
+void DeviceBenchmark::demarshall_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("driversPerDevice");
+
+    QTest::newRow("1") << 1 << 1;
+    QTest::newRow("50") << 50 << 2;
+    QTest::newRow("500") << 500 << 3;
+}
+
+void DeviceBenchmark::demarshall()
+{
+    QFETCH(int, count);
+    QFETCH(int, driversPerDevice);
+
+    m_manager.m_devices = FakeDriverManager::generateDevices(count, driversPerDevice);
+
+    QDBusConnection client = QDBusConnection::connectToPeer(m_server->address(),
+                                                            QString::fromLatin1(QTest::currentDataTag()));
+    QVERIFY(client.isConnected());
+    QDBusMessage call = QDBusMessage::createMethodCall(QString(), "/DriverManager",
+                                                       "org.kubuntu.DriverManager", "devices");
+    // The server side runs in this thread, keep the event loop going.
+    const QDBusMessage reply = client.call(call, QDBus::BlockWithGui);
+    QDBusConnection::disconnectFromPeer(client.name());
+    QCOMPARE(reply.type(), QDBusMessage::ReplyMessage);
+    const QDBusArgument argument = reply.arguments().first().value<QDBusArgument>();
+
+    DeviceList devices;
+    QBENCHMARK {
+        devices.clear();
+        // Each copy reads from the start.
+        QDBusArgument copy = argument;
+        copy >> devices;
+    }
+
+    QCOMPARE(devices.size(), count);
+    const Device &device = devices.first();
+    QVERIFY(device.id.startsWith("/sys/devices/pci0000:00/"));
+    QVERIFY(device.modalias.startsWith("pci:v000010DEd"));
+    QCOMPARE(device.vendor, QStringLiteral("NVIDIA Corporation"));
+    QCOMPARE(device.drivers.size(), driversPerDevice);
+    QVERIFY(device.drivers.first().recommended);
+    QVERIFY(device.drivers.first().fromDistro);
+    QVERIFY(!device.drivers.first().free);
+}
+
+QTEST_GUILESS_MAIN(DeviceBenchmark);
+
+#include "devicebenchmark.moc"
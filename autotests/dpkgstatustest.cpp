@@ -0,0 +1,109 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <QObject>
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "../src/daemon/dpkgstatus.h"
+
+class DpkgStatusTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void isInstalled_data();
+    void isInstalled();
+    void missing();
+    void refresh();
+};
+
+void DpkgStatusTest::isInstalled_data()
+{
+    QTest::addColumn<QString>("package");
+    QTest::addColumn<bool>("installed");
+
+    QTest::newRow("installed") << "nvidia-driver-470" << true;
+    QTest::newRow("installed arch") << "nvidia-driver-470:amd64" << true;
+    QTest::newRow("wrong arch") << "nvidia-driver-470:i386" << false;
+    QTest::newRow("config-files") << "libk3b7-extracodecs" << false;
+    QTest::newRow("half-configured") << "bcmwl-kernel-source" << true;
+    QTest::newRow("multiarch") << "libmp3lame0" << true;
+    QTest::newRow("multiarch foreign") << "libmp3lame0:i386" << true;
+    QTest::newRow("multiarch native") << "libmp3lame0:amd64" << true;
+    QTest::newRow("foreign only") << "libnvidia-gl-470" << true;
+    QTest::newRow("foreign only qualified") << "libnvidia-gl-470:i386" << true;
+    QTest::newRow("foreign only native") << "libnvidia-gl-470:amd64" << false;
+    QTest::newRow("arch all") << "fonts-noto" << true;
+    QTest::newRow("arch all qualified") << "fonts-noto:all" << false;
+    QTest::newRow("not-installed last stanza") << "virtualbox-guest-dkms" << false;
+    QTest::newRow("unknown") << "fglrx" << false;
+}
+
+void DpkgStatusTest::isInstalled()
+{
+    QFETCH(QString, package);
+    QFETCH(bool, installed);
+
+    DpkgStatus status(QStringLiteral(TEST_DATA "/dpkgstatus/status"));
+    QVERIFY(status.refresh());
+    QCOMPARE(status.isInstalled(package), installed);
+}
+
+void DpkgStatusTest::missing()
+{
+    DpkgStatus status(QStringLiteral("/does/not/exist/status"));
+    status.refresh();
+    QVERIFY(!status.isInstalled(QStringLiteral("dpkg")));
+}
+
+void DpkgStatusTest::refresh()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path() + QLatin1String("/status");
+
+    QFile file(path);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("Package: foo\nStatus: install ok installed\n");
+    file.close();
+
+    DpkgStatus status(path);
+    QVERIFY(!status.isInstalled(QStringLiteral("foo"))); // not parsed yet
+    QVERIFY(status.refresh());
+    QVERIFY(status.isInstalled(QStringLiteral("foo")));
+    QVERIFY(!status.refresh()); // unchanged
+
+    // dpkg replaces the file, size changes even within the same second.
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write("Package: foo\nStatus: deinstall ok config-files\n\n"
+               "Package: bar\nStatus: install ok installed\n");
+    file.close();
+
+    // Lookups stay on the index they were given until the next refresh.
+    QVERIFY(status.isInstalled(QStringLiteral("foo")));
+    QVERIFY(status.refresh());
+    QVERIFY(!status.isInstalled(QStringLiteral("foo")));
+    QVERIFY(status.isInstalled(QStringLiteral("bar")));
+}
+
+QTEST_GUILESS_MAIN(DpkgStatusTest);
+
+#include "dpkgstatustest.moc"
@@ -0,0 +1,294 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+// Drives DriverEvent against FakeDriverManager registered as
+// org.kubuntu.DriverManager on a private dbus-daemon. Devices and installed
+// packages come from fixtures. Covers timing of onDevicesReady() and of full
+// queries, leaks across repeated queries and the behavior on slow, failing
+// and hanging services, e.g.:
+//   drivereventtest -o drivereventtest.csv,csv
+
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QProcess>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QVariantMap>
+#include <QtTest>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+#include "../src/daemon/driverevent/driverevent.h"
+#include "../src/daemon/driverevent/ueventsource.h"
+#include "fakedrivermanager.h"
+
+class DriverEventTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void onDevicesReady_data();
+    void onDevicesReady();
+    void query_data();
+    void query();
+    void latency();
+    void retry();
+    void giveUp();
+    void hang();
+    void cancel();
+    void leaks();
+
+private:
+    // Starts a full query and returns once onDevicesReady() handled it.
+    void runQuery();
+
+    QProcess m_bus;
+    // Stands in for /sys/bus.
+    QTemporaryDir m_busRoot;
+    FakeDriverManager m_manager;
+    UEventSource m_uevents;
+    DriverEvent *m_event;
+};
+
+void DriverEventTest::runQuery()
+{
+    m_event->queryDevices();
+    QVERIFY(m_event->m_pendingCall);
+    // onDevicesReady() is connected first and thus done once this fires.
+    QEventLoop loop;
+    connect(m_event->m_pendingCall, &QDBusPendingCallWatcher::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+void DriverEventTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    m_bus.setProcessChannelMode(QProcess::SeparateChannels);
+    m_bus.start(QStringLiteral("dbus-daemon"),
+                QStringList() << "--session" << "--nofork" << "--print-address");
+    if (!m_bus.waitForStarted() || !m_bus.waitForReadyRead()) {
+        QSKIP("dbus-daemon not available");
+    }
+    const QByteArray address = m_bus.readLine().trimmed();
+    QVERIFY(!address.isEmpty());
+    // DriverEvent talks to the session bus, make that ours.
+    qputenv("DBUS_SESSION_BUS_ADDRESS", address);
+
+    FakeDriverManager::registerTypes();
+    QDBusConnection service = QDBusConnection::connectToBus(QString::fromLatin1(address),
+                                                            QStringLiteral("fakedrivermanager"));
+    QVERIFY(service.isConnected());
+    QVERIFY(service.registerObject("/DriverManager", &m_manager, QDBusConnection::ExportAllSlots));
+    QVERIFY(service.registerService("org.kubuntu.DriverManager"));
+
+    QVERIFY(m_busRoot.isValid());
+    const QStringList aliases = QStringList()
+            << "pci:v000010DEd00001C82sv00001043sd00008613bc03sc00i00"
+            << "usb:v8087p0029d0001dcE0dsc01dp01icE0isc01ip01in00";
+    for (int i = 0; i < aliases.size(); ++i) {
+        const QString device = m_busRoot.path() + QStringLiteral("/bus%1/devices/device%1").arg(i);
+        QVERIFY(QDir().mkpath(device));
+        QFile file(device + QLatin1String("/modalias"));
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write(aliases.at(i).toLatin1() + '\n');
+    }
+}
+
+void DriverEventTest::cleanupTestCase()
+{
+    QDBusConnection::disconnectFromBus(QStringLiteral("fakedrivermanager"));
+    m_bus.terminate();
+    m_bus.waitForFinished();
+}
+
+void DriverEventTest::init()
+{
+    m_manager.m_devices = FakeDriverManager::generateDevices(10, 2);
+    m_manager.m_latency = 0;
+    m_manager.m_errors = 0;
+    m_manager.m_hang = false;
+
+    // No cached decision, so construction queries right away.
+    KConfig cfg("notificationhelper");
+    KConfigGroup driverGroup(&cfg, "Driver");
+    driverGroup.deleteEntry("CacheKey");
+    driverGroup.sync();
+
+    m_event = new DriverEvent(nullptr, &m_uevents, m_busRoot.path(),
+                              QStringLiteral(TEST_DATA "/dpkgstatus/status"));
+    // Decisions are what is measured, not notifications.
+    m_event->m_notified = true;
+    QTRY_COMPARE(m_event->m_state, DriverEvent::Idle);
+    // Short deadlines so failure paths finish quickly, the config only
+    // takes whole seconds.
+    m_event->m_callTimeout = 300;
+    m_event->m_retryDelay = 200;
+}
+
+void DriverEventTest::cleanup()
+{
+    delete m_event;
+    m_event = nullptr;
+}
+
+void DriverEventTest::onDevicesReady_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("50") << 50;
+    QTest::newRow("500") << 500;
+}
+
+void DriverEventTest::onDevicesReady()
+{
+    QFETCH(int, count);
+
+    m_manager.m_devices = FakeDriverManager::generateDevices(count, 3);
+    QDBusMessage call = QDBusMessage::createMethodCall("org.kubuntu.DriverManager", "/DriverManager",
+                                                       "org.kubuntu.DriverManager", "devices");
+    const QDBusMessage reply = QDBusConnection::sessionBus().call(call, QDBus::BlockWithGui);
+    QCOMPARE(reply.type(), QDBusMessage::ReplyMessage);
+
+    QBENCHMARK {
+        auto watcher = new QDBusPendingCallWatcher(QDBusPendingCall::fromCompletedCall(reply), m_event);
+        m_event->m_state = DriverEvent::Querying;
+        m_event->onDevicesReady(watcher);
+    }
+    QCOMPARE(m_event->m_state, DriverEvent::Idle);
+    // None of the generated drivers is installed.
+    QVERIFY(m_event->m_showNotification);
+}
+
+void DriverEventTest::query_data()
+{
+    onDevicesReady_data();
+}
+
+void DriverEventTest::query()
+{
+    QFETCH(int, count);
+
+    m_manager.m_devices = FakeDriverManager::generateDevices(count, 3);
+    QBENCHMARK {
+        runQuery();
+    }
+    QCOMPARE(m_event->m_state, DriverEvent::Idle);
+    QVERIFY(m_event->m_knownModaliases.size() >= count);
+}
+
+void DriverEventTest::latency()
+{
+    m_manager.m_latency = 300;
+    const int calls = m_manager.m_calls;
+    runQuery();
+    QCOMPARE(m_manager.m_calls, calls + 1);
+    QVERIFY(m_event->m_lastCallDuration >= 300);
+    QCOMPARE(m_event->m_state, DriverEvent::Idle);
+}
+
+void DriverEventTest::retry()
+{
+    m_manager.m_errors = 1;
+    const int calls = m_manager.m_calls;
+    const int failed = m_event->m_failedCallCount;
+
+    m_event->queryDevices();
+    QTRY_COMPARE(m_event->m_state, DriverEvent::RetryWaiting);
+    QTRY_COMPARE(m_event->m_state, DriverEvent::Idle);
+
+    QCOMPARE(m_manager.m_calls, calls + 2);
+    QCOMPARE(m_event->m_failedCallCount, failed + 1);
+    KConfig cfg("notificationhelper");
+    QCOMPARE(KConfigGroup(&cfg, "Driver").readEntry("CacheKey", QString()), m_event->m_queryKey);
+}
+
+void DriverEventTest::giveUp()
+{
+    m_manager.m_errors = 100;
+    const int calls = m_manager.m_calls;
+
+    m_event->queryDevices();
+    // Backs off 200ms and 400ms between the three attempts.
+    QTRY_COMPARE(m_event->m_state, DriverEvent::Idle);
+    QCOMPARE(m_manager.m_calls, calls + 3);
+}
+
+void DriverEventTest::hang()
+{
+    m_manager.m_hang = true;
+    const int failed = m_event->m_failedCallCount;
+
+    m_event->queryDevices();
+    QCOMPARE(m_event->m_state, DriverEvent::Querying);
+    // Three attempts running into the deadline plus back off.
+    QTRY_COMPARE(m_event->m_failedCallCount, failed + 3);
+    QCOMPARE(m_event->m_state, DriverEvent::Idle);
+    QVERIFY(!m_event->m_pendingCall);
+}
+
+void DriverEventTest::cancel()
+{
+    m_manager.m_hang = true;
+
+    m_event->queryDevices();
+    QCOMPARE(m_event->m_state, DriverEvent::Querying);
+    emit m_event->hidden();
+    QCOMPARE(m_event->m_state, DriverEvent::Idle);
+    QVERIFY(!m_event->m_pendingCall);
+
+    // Nothing fires later on.
+    const int calls = m_event->m_callCount;
+    QTest::qWait(m_event->m_callTimeout + m_event->m_retryDelay);
+    QCOMPARE(m_event->m_callCount, calls);
+}
+
+void DriverEventTest::leaks()
+{
+    m_manager.m_devices = FakeDriverManager::generateDevices(500, 3);
+    for (int i = 0; i < 10; ++i) {
+        runQuery();
+    }
+    // Every reply is done with once handled.
+    QTest::qWait(0);
+    QVERIFY(m_event->findChildren<QDBusPendingCallWatcher *>().isEmpty());
+    QVERIFY(!m_event->m_pendingCall);
+}
+
+QTEST_GUILESS_MAIN(DriverEventTest);
+
+#include "drivereventtest.moc"
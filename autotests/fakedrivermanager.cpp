@@ -0,0 +1,97 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "fakedrivermanager.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QTimer>
+
+FakeDriverManager::FakeDriverManager(QObject *parent)
+    : QObject(parent)
+    , m_latency(0)
+    , m_errors(0)
+    , m_hang(false)
+    , m_calls(0)
+{
+}
+
+void FakeDriverManager::registerTypes()
+{
+    qDBusRegisterMetaType<DriverFlags>();
+    qDBusRegisterMetaType<DriverMap>();
+    qDBusRegisterMetaType<DeviceMap>();
+}
+
+DeviceMap FakeDriverManager::generateDevices(int count, int driversPerDevice)
+{
+    DeviceMap devices;
+    for (int i = 0; i < count; ++i) {
+        DriverMap drivers;
+        for (int j = 0; j < driversPerDevice; ++j) {
+            DriverFlags flags;
+            flags.insert("recommended", j == 0);
+            flags.insert("free", j % 2 == 1);
+            flags.insert("from_distro", true);
+            flags.insert("builtin", false);
+            flags.insert("manual_install", false);
+            drivers.insert(QStringLiteral("driver-%1-%2").arg(i).arg(j), flags);
+        }
+
+        QVariantMap device;
+        device.insert("modalias", QStringLiteral("pci:v000010DEd%1sv00001043sd00008613bc03sc00i00")
+                                      .arg(i, 8, 16, QLatin1Char('0')));
+        device.insert("vendor", "NVIDIA Corporation");
+        device.insert("model", QStringLiteral("Generated Device %1").arg(i));
+        device.insert("drivers", QVariant::fromValue(drivers));
+        devices.insert(QStringLiteral("/sys/devices/pci0000:00/0000:00:%1.0").arg(i), device);
+    }
+    return devices;
+}
+
+DeviceMap FakeDriverManager::devices()
+{
+    ++m_calls;
+
+    if (!calledFromDBus()) {
+        return m_devices;
+    }
+    if (m_hang) {
+        setDelayedReply(true);
+        return DeviceMap();
+    }
+    if (m_errors > 0) {
+        --m_errors;
+        sendErrorReply(QDBusError::Failed, QStringLiteral("injected error"));
+        return DeviceMap();
+    }
+    if (m_latency > 0) {
+        setDelayedReply(true);
+        const QDBusMessage reply = message().createReply(QVariant::fromValue(m_devices));
+        const QDBusConnection bus = connection();
+        QTimer::singleShot(m_latency, this, [bus, reply]() {
+            QDBusConnection(bus).send(reply);
+        });
+        return DeviceMap();
+    }
+    return m_devices;
+}
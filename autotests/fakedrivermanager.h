@@ -0,0 +1,71 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef FAKEDRIVERMANAGER_H
+#define FAKEDRIVERMANAGER_H
+
+#include <QDBusContext>
+#include <QObject>
+#include <QVariantMap>
+
+typedef QMap<QString, bool> DriverFlags;
+typedef QMap<QString, DriverFlags> DriverMap;
+typedef QMap<QString, QVariantMap> DeviceMap;
+Q_DECLARE_METATYPE(DriverFlags)
+Q_DECLARE_METATYPE(DriverMap)
+Q_DECLARE_METATYPE(DeviceMap)
+
+/**
+ * Stand-in for the org.kubuntu.DriverManager service, speaking the wire
+ * format of its devices() method. Latency, errors and hangs can be injected.
+ */
+class FakeDriverManager : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kubuntu.DriverManager")
+public:
+    explicit FakeDriverManager(QObject *parent = nullptr);
+
+    /** Registers the DBus types of the reply, call before using the service. */
+    static void registerTypes();
+
+    /**
+     * Generates @p count devices with @p driversPerDevice drivers each. The
+     * first driver of every device is the recommended one.
+     */
+    static DeviceMap generateDevices(int count, int driversPerDevice);
+
+    /** Reply of devices(). */
+    DeviceMap m_devices;
+    /** Delay before replying in milliseconds. */
+    int m_latency;
+    /** Number of upcoming calls answered with an error. */
+    int m_errors;
+    /** Never answer. */
+    bool m_hang;
+    /** Number of devices() calls received. */
+    int m_calls;
+
+public Q_SLOTS:
+    DeviceMap devices();
+};
+
+#endif // FAKEDRIVERMANAGER_H
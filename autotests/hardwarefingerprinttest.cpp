@@ -0,0 +1,84 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <QObject>
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "../src/daemon/driverevent/hardwarefingerprint.h"
+
+class HardwareFingerprintTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void modaliases();
+    void compute();
+
+private:
+    static void addDevice(const QString &root, const QString &bus, const QString &device,
+                          const QByteArray &modalias = QByteArray());
+};
+
+void HardwareFingerprintTest::addDevice(const QString &root, const QString &bus,
+                                        const QString &device, const QByteArray &modalias)
+{
+    const QString path = QStringLiteral("%1/%2/devices/%3").arg(root, bus, device);
+    QVERIFY(QDir().mkpath(path));
+    if (modalias.isNull()) {
+        return;
+    }
+    QFile file(path + QLatin1String("/modalias"));
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(modalias + '\n');
+}
+
+void HardwareFingerprintTest::modaliases()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    addDevice(dir.path(), "pci", "0000:01:00.0", "pci:v000010DEd00001C82sv00001043sd00008613bc03sc00i00");
+    addDevice(dir.path(), "pci", "0000:00:00.0", "pci:v00008086d00003E30sv00001043sd00008694bc06sc00i00");
+    addDevice(dir.path(), "usb", "1-1", "usb:v046DpC52Bd1211dc00dsc00dp00ic03isc01ip01in00");
+    addDevice(dir.path(), "usb", "usb1"); // no modalias
+    QVERIFY(QDir().mkpath(dir.path() + "/empty/devices"));
+
+    const QStringList expected = QStringList()
+        << "pci:v000010DEd00001C82sv00001043sd00008613bc03sc00i00"
+        << "pci:v00008086d00003E30sv00001043sd00008694bc06sc00i00"
+        << "usb:v046DpC52Bd1211dc00dsc00dp00ic03isc01ip01in00";
+    QCOMPARE(HardwareFingerprint::modaliases(dir.path()), expected);
+    QVERIFY(HardwareFingerprint::modaliases(dir.path() + "/nope").isEmpty());
+}
+
+void HardwareFingerprintTest::compute()
+{
+    const QStringList a = QStringList() << "pci:a" << "pci:b";
+    const QByteArray fingerprint = HardwareFingerprint::compute(a);
+    QCOMPARE(fingerprint.size(), 40);
+    QCOMPARE(HardwareFingerprint::compute(a), fingerprint);
+    QVERIFY(HardwareFingerprint::compute(QStringList() << "pci:a") != fingerprint);
+    // Separated, not concatenated.
+    QVERIFY(HardwareFingerprint::compute(QStringList() << "pci:apci:b") != fingerprint);
+}
+
+QTEST_GUILESS_MAIN(HardwareFingerprintTest);
+
+#include "hardwarefingerprinttest.moc"
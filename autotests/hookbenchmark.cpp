@@ -0,0 +1,230 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+// Benchmarks for the hook parser and locale resolution.
+// Inputs are generated deterministically so numbers are comparable across
+// releases, e.g.:
+//   hookbenchmark -median 5 -o hookbenchmark.csv,csv
+
+#include <QObject>
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "../src/daemon/hookevent/hook.h"
+#include "../src/daemon/hookevent/locale.h"
+
+class HookBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+
+    void parse_data();
+    void parse();
+    void getField_data();
+    void getField();
+    void signature_data();
+    void signature();
+    void combinations_data();
+    void combinations();
+
+private:
+    static QByteArray generateHook(int size, int continuationRatio, int localeCount = 0);
+    QString writeHook(const QString &name, const QByteArray &data);
+
+    QTemporaryDir m_dir;
+};
+
+// Generates a valid hook of roughly @p size bytes. Every
+// @p continuationRatio'th line is a continuation line (0 for none).
+// @p localeCount adds that many localized Name-xx_YY fields up front.
+QByteArray HookBenchmark::generateHook(int size, int continuationRatio, int localeCount)
+{
+    QByteArray data;
+    data.reserve(size + 1024);
+    data += "Name: benchmark hook\n";
+    for (int i = 0; i < localeCount; ++i) {
+        data += "Name-l" + QByteArray::number(i) + "_C" + QByteArray::number(i)
+                + ": localized name " + QByteArray::number(i) + '\n';
+    }
+    data += "Command: /bin/true\n";
+    data += "Terminal: False\n";
+    data += "Description: a generated hook description\n";
+    for (int line = 0; data.size() < size; ++line) {
+        if (continuationRatio > 0 && line % continuationRatio != 0) {
+            data += " continuation of the previous field with some more words\n";
+        } else {
+            data += "Field" + QByteArray::number(line) + ": value of field "
+                    + QByteArray::number(line) + '\n';
+        }
+    }
+    return data;
+}
+
+QString HookBenchmark::writeHook(const QString &name, const QByteArray &data)
+{
+    const QString path = m_dir.path() + QLatin1Char('/') + name;
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate) || file.write(data) != data.size()) {
+        qFatal("failed to write %s", qPrintable(path));
+    }
+    return path;
+}
+
+void HookBenchmark::initTestCase()
+{
+    // Hook construction reads finished-state from the config.
+    QStandardPaths::setTestModeEnabled(true);
+    setlocale(LC_ALL, "en_US.UTF-8");
+    QVERIFY(m_dir.isValid());
+}
+
+void HookBenchmark::parse_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("continuationRatio");
+
+    QTest::newRow("1KiB") << 1024 << 0;
+    QTest::newRow("64KiB") << 64 * 1024 << 0;
+    QTest::newRow("1MiB") << 1024 * 1024 << 0;
+    QTest::newRow("10MiB") << 10 * 1024 * 1024 << 0;
+    QTest::newRow("1KiB-continuations") << 1024 << 16;
+    QTest::newRow("1MiB-continuations") << 1024 * 1024 << 16;
+    QTest::newRow("10MiB-continuations") << 10 * 1024 * 1024 << 16;
+}
+
+void HookBenchmark::parse()
+{
+    QFETCH(int, size);
+    QFETCH(int, continuationRatio);
+
+    const QByteArray data = generateHook(size, continuationRatio);
+    const QString path = writeHook(QString::fromLatin1(QTest::currentDataTag()), data);
+
+    Hook hook(nullptr, path);
+    QVERIFY(hook.isValid());
+
+    QMap<QString, QString> fields;
+    QBENCHMARK {
+        fields = hook.parse(path);
+    }
+    QVERIFY(!fields.isEmpty());
+}
+
+void HookBenchmark::getField_data()
+{
+    QTest::addColumn<int>("localeCount");
+    QTest::addColumn<QString>("locale");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("none-fallback") << 0 << "de_DE@euro.UTF-8" << "benchmark hook";
+    QTest::newRow("100-fallback") << 100 << "de_DE@euro.UTF-8" << "benchmark hook";
+    QTest::newRow("500-fallback") << 500 << "de_DE@euro.UTF-8" << "benchmark hook";
+    QTest::newRow("500-hit") << 500 << "l499_C499.UTF-8" << "localized name 499";
+}
+
+void HookBenchmark::getField()
+{
+    QFETCH(int, localeCount);
+    QFETCH(QString, locale);
+    QFETCH(QString, expected);
+
+    const QByteArray data = generateHook(4096, 0, localeCount);
+    const QString path = writeHook(QString::fromLatin1(QTest::currentDataTag()), data);
+
+    Hook hook(nullptr, path);
+    hook.setLocale(locale);
+
+    QString value;
+    QBENCHMARK {
+        value = hook.getField(QStringLiteral("Name"));
+    }
+    QCOMPARE(value, expected);
+}
+
+void HookBenchmark::signature_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1KiB") << 1024;
+    QTest::newRow("1MiB") << 1024 * 1024;
+    QTest::newRow("10MiB") << 10 * 1024 * 1024;
+}
+
+void HookBenchmark::signature()
+{
+    QFETCH(int, size);
+
+    const QString path = writeHook(QString::fromLatin1(QTest::currentDataTag()),
+                                   generateHook(size, 0));
+    Hook hook(nullptr, path);
+
+    QString signature;
+    QBENCHMARK {
+        signature = hook.calculateSignature();
+    }
+    QCOMPARE(signature, hook.signature());
+}
+
+void HookBenchmark::combinations_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("100") << 100;
+    QTest::newRow("500") << 500;
+}
+
+void HookBenchmark::combinations()
+{
+    QFETCH(int, count);
+
+    QStringList locales;
+    for (int i = 0; i < count; ++i) {
+        switch (i % 4) {
+        case 0:
+            locales << QStringLiteral("l%1").arg(i);
+            break;
+        case 1:
+            locales << QStringLiteral("l%1_C%1").arg(i);
+            break;
+        case 2:
+            locales << QStringLiteral("l%1_C%1.UTF-8").arg(i);
+            break;
+        default:
+            locales << QStringLiteral("l%1_C%1@variant.UTF-8").arg(i);
+            break;
+        }
+    }
+
+    int total = 0;
+    QBENCHMARK {
+        total = 0;
+        foreach (const QString &str, locales) {
+            Locale locale(str);
+            total += locale.combinations().size();
+        }
+    }
+    QVERIFY(total >= count);
+}
+
+QTEST_GUILESS_MAIN(HookBenchmark);
+
+#include "hookbenchmark.moc"
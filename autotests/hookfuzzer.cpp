@@ -0,0 +1,52 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+// libFuzzer target for the hook field and bundle parsers.
+// Build with -DBUILD_FUZZERS=ON using clang, then e.g.:
+//   hookfuzzer -max_len=65536 corpus/ ../autotests/data/hooktest/
+
+#include <QByteArray>
+
+#include <stdint.h>
+
+#include "../src/daemon/hookevent/hook.h"
+#include "../src/daemon/hookevent/locale.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                                     static_cast<int>(size));
+
+    // The input as a single hook, as found in user.d.
+    Hook hook(nullptr, QString(), QStringLiteral("fuzz"), bytes);
+    if (hook.isValid()) {
+        // Localized lookups run the locale splitter, feed it the input's
+        // first line as well.
+        const int eol = bytes.indexOf('\n');
+        hook.setLocale(QString::fromUtf8(bytes.left(eol < 0 ? 64 : qMin(eol, 64))));
+        hook.getField(QStringLiteral("Name"));
+        hook.getField(QStringLiteral("Description"));
+    }
+    Locale(QString::fromUtf8(bytes.left(64))).combinations();
+
+    // And as a bundle, index and offsets included.
+    qDeleteAll(Hook::parseBundle(nullptr, QString(), bytes));
+    return 0;
+}
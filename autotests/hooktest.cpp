@@ -20,6 +20,7 @@
 
 #include <QObject>
 #include <QtTest>
+#include <QTemporaryDir>
 
 #include "../src/daemon/hookevent/hook.h"
 
@@ -33,6 +34,8 @@ private Q_SLOTS:
     void ctor();
     void validFile();
     void invalidFile();
+    void bundle();
+    void invalidBundle();
 
 private:
     QString data(const QString func);
@@ -76,6 +79,50 @@ void HookTest::invalidFile()
     QVERIFY(!h.isValid());
 }
 
+void HookTest::bundle()
+{
+    QList<Hook *> hooks = Hook::parseBundle(nullptr, data("bundle"));
+    QCOMPARE(hooks.size(), 3);
+
+    Hook *h = hooks.at(0);
+    QVERIFY(h->isValid());
+    QCOMPARE(h->getField("Name"), QString("apt-file update needed"));
+    QCOMPARE(h->getField("Command"), QString("\"/usr/share/apt-file/do-apt-file-update\""));
+    h->setLocale("de_DE.UTF-8");
+    QCOMPARE(h->getField("Name"), QString("sauerkraut lederhosen"));
+
+    QVERIFY(hooks.at(1)->isValid());
+    QCOMPARE(hooks.at(1)->getField("Description"), QString("from a bundle"));
+    QVERIFY(!hooks.at(2)->isValid());
+
+    // Every entry keeps its own identity, and it does not collide with the
+    // same content shipped as a standalone file.
+    QVERIFY(hooks.at(0)->signature() != hooks.at(1)->signature());
+    Hook file(nullptr, data("validFile"));
+    QVERIFY(hooks.at(0)->signature() != file.signature());
+
+    qDeleteAll(hooks);
+}
+
+void HookTest::invalidBundle()
+{
+    // Regular hooks are no bundles.
+    QVERIFY(Hook::parseBundle(nullptr, data("validFile")).isEmpty());
+    QVERIFY(Hook::parseBundle(nullptr, data("doesNotExist")).isEmpty());
+
+    // offset + length overflows, the entry must not pass the bounds check.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QFile file(dir.path() + "/bundle");
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("Bundle-Format: 1\n"
+               "9223372036854775800 100 overflow\n"
+               "\n"
+               "Name: x\n");
+    file.close();
+    QVERIFY(Hook::parseBundle(nullptr, file.fileName()).isEmpty());
+}
+
 QString HookTest::data(const QString func)
 {
     return m_dataPath + "/" + func;
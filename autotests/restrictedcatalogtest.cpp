@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/daemon/installevent/restrictedcatalog.h"
+
+class RestrictedCatalogTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void shipped();
+    void merge();
+    void missing();
+};
+
+void RestrictedCatalogTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void RestrictedCatalogTest::shipped()
+{
+    // The catalog installed from data/.
+    const QString shipped = QStringLiteral(TEST_DATA "/../../data/restricted-packages");
+    RestrictedCatalog catalog;
+    catalog.load(QStringList() << shipped, shipped);
+    QCOMPARE(catalog.groupCount(), 2);
+    // The translator context is not a package of its own.
+    QCOMPARE(catalog.packageCount(), 3);
+
+    QMap<QString, QString> multimedia;
+    multimedia["libk3b6-extracodecs"] = QStringLiteral("K3b CD Codecs");
+    multimedia["libmp3lame0"] = QStringLiteral("MP3 Encoding");
+    QCOMPARE(catalog.group(QStringLiteral("libmp3lame0")), multimedia);
+    QCOMPARE(catalog.group(QStringLiteral("libk3b6-extracodecs")), multimedia);
+    QCOMPARE(catalog.group(QStringLiteral("flashplugin-installer")).keys(),
+             QStringList() << "flashplugin-installer");
+    // No translations installed here, the name is looked up as is.
+    QCOMPARE(catalog.group(QStringLiteral("flashplugin-installer")).value("flashplugin-installer"),
+             QStringLiteral("Flash"));
+    QVERIFY(catalog.group(QStringLiteral("fglrx")).isEmpty());
+}
+
+void RestrictedCatalogTest::merge()
+{
+    const QString shipped = QStringLiteral(TEST_DATA "/../../data/restricted-packages");
+    RestrictedCatalog catalog;
+    catalog.load(QStringList()
+                 << shipped
+                 << QStringLiteral(TEST_DATA "/restrictedcatalog/vendor/restricted-packages"),
+                 shipped);
+    QCOMPARE(catalog.groupCount(), 4);
+    // The localized name is not a package of its own.
+    QCOMPARE(catalog.packageCount(), 6);
+
+    QCOMPARE(catalog.group(QStringLiteral("gstreamer1.0-libav")).keys(),
+             QStringList() << "gstreamer1.0-libav" << "gstreamer1.0-plugins-ugly");
+    // Listed in both, the first file wins.
+    QCOMPARE(catalog.group(QStringLiteral("libmp3lame0")).value("libmp3lame0"),
+             QStringLiteral("MP3 Encoding"));
+    QCOMPARE(catalog.group(QStringLiteral("lame")).keys(), QStringList() << "lame");
+
+    // Loading again replaces the catalog.
+    catalog.load(QStringList() << QStringLiteral(TEST_DATA "/restrictedcatalog/vendor/restricted-packages"));
+    QCOMPARE(catalog.groupCount(), 2);
+    QCOMPARE(catalog.group(QStringLiteral("libmp3lame0")).value("libmp3lame0"),
+             QStringLiteral("LAME"));
+    QVERIFY(catalog.group(QStringLiteral("flashplugin-installer")).isEmpty());
+}
+
+void RestrictedCatalogTest::missing()
+{
+    RestrictedCatalog catalog;
+    catalog.load(QStringList() << QStringLiteral("/does/not/exist/restricted-packages"));
+    QCOMPARE(catalog.groupCount(), 0);
+    QVERIFY(catalog.group(QStringLiteral("libmp3lame0")).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(RestrictedCatalogTest);
+
+#include "restrictedcatalogtest.moc"
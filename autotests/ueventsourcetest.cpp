@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include <QObject>
+#include <QtTest>
+
+#include "../src/daemon/driverevent/ueventsource.h"
+
+// Feeds synthetic kernel messages.
+class FakeUEventSource : public UEventSource
+{
+public:
+    void inject(const QByteArray &message)
+    {
+        processMessage(message.constData(), message.size());
+    }
+};
+
+class UEventSourceTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void process_data();
+    void process();
+};
+
+// Builds a kernel style message, properties are separated by NUL.
+static QByteArray message(const QByteArray &action, const QByteArray &devpath,
+                          const QList<QByteArray> &properties)
+{
+    QByteArray data = action + '@' + devpath;
+    data += '\0';
+    data += "ACTION=" + action;
+    data += '\0';
+    data += "DEVPATH=" + devpath;
+    data += '\0';
+    foreach (const QByteArray &property, properties) {
+        data += property;
+        data += '\0';
+    }
+    return data;
+}
+
+void UEventSourceTest::process_data()
+{
+    QTest::addColumn<QByteArray>("message");
+    QTest::addColumn<QString>("devpath");
+    QTest::addColumn<QString>("modalias");
+
+    const QByteArray pci = "/devices/pci0000:00/0000:00:1c.0/0000:02:00.0";
+    const QByteArray alias = "pci:v000014E4d000043B1sv00001A3Bsd00002123bc02sc80i00";
+
+    QTest::newRow("add")
+        << message("add", pci, QList<QByteArray>() << "SUBSYSTEM=pci" << "MODALIAS=" + alias << "SEQNUM=2154")
+        << QString::fromLatin1(pci) << QString::fromLatin1(alias);
+    QTest::newRow("bind")
+        << message("bind", pci, QList<QByteArray>() << "MODALIAS=" + alias << "DRIVER=wl")
+        << QString::fromLatin1(pci) << QString::fromLatin1(alias);
+    QTest::newRow("remove")
+        << message("remove", pci, QList<QByteArray>() << "MODALIAS=" + alias)
+        << QString() << QString();
+    QTest::newRow("change")
+        << message("change", pci, QList<QByteArray>() << "MODALIAS=" + alias)
+        << QString() << QString();
+    QTest::newRow("no modalias")
+        << message("add", "/devices/virtual/net/lo", QList<QByteArray>() << "SUBSYSTEM=net")
+        << QString() << QString();
+    QTest::newRow("udevd")
+        << QByteArray("libudev\0\xfe\xed\xca\xfe", 12) << QString() << QString();
+    QTest::newRow("unterminated")
+        << message("add", pci, QList<QByteArray>()) + "MODALIAS=" + alias
+        << QString::fromLatin1(pci) << QString::fromLatin1(alias);
+}
+
+void UEventSourceTest::process()
+{
+    QFETCH(QByteArray, message);
+    QFETCH(QString, devpath);
+    QFETCH(QString, modalias);
+
+    FakeUEventSource source;
+    QSignalSpy spy(&source, &UEventSource::deviceAdded);
+    source.inject(message);
+
+    if (modalias.isEmpty()) {
+        QCOMPARE(spy.count(), 0);
+        return;
+    }
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.first().at(0).toString(), devpath);
+    QCOMPARE(spy.first().at(1).toString(), modalias);
+}
+
+QTEST_GUILESS_MAIN(UEventSourceTest);
+
+#include "ueventsourcetest.moc"
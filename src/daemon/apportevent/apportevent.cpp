@@ -24,27 +24,90 @@
 #include <QDebug>
 #include <QStandardPaths>
 #include <QDir>
+#include <QProcess>
+#include <QTimer>
 
-#include <KProcess>
+#include <KConfig>
+#include <KConfigGroup>
 #include <KToolInvocation>
-#include <KDirWatch>
 
-ApportEvent::ApportEvent(QObject* parent)
-        : Event(parent, "Apport")
+#include "../coalescer.h"
+#include "../filewatcher.h"
+#include "crashheader.h"
+#include "crashreports.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+static qint64 readCrashBurstWindow()
+{
+    KConfig cfg("notificationhelper");
+    KConfigGroup apportGroup(&cfg, "Apport");
+    // Seconds without crash after which a crash loop is considered over.
+    return apportGroup.readEntry("CrashBurstWindow", 60) * 1000;
+}
+
+// Child in a new session, neither the session's SIGHUP nor kded's process
+// group reach it.
+class SessionProcess : public QProcess
+{
+public:
+    explicit SessionProcess(QObject *parent)
+        : QProcess(parent)
+    {}
+
+protected:
+    void setupChildProcess() Q_DECL_OVERRIDE
+    {
+        ::setsid();
+    }
+};
+
+bool ApportEvent::isAvailable()
 {
     const bool apportKde = QFile::exists("/usr/share/apport/apport-kde");
     const bool apportGtk = QFile::exists("/usr/share/apport/apport-gtk");
     qDebug() << "ApportEvent ::"
              << "apport-kde=" << apportKde
              << "apport-gtk=" << apportGtk;
-    if (!apportKde && !apportGtk) {
-        return;
-    }
+    return apportKde || apportGtk;
+}
+
+ApportEvent::ApportEvent(QObject* parent, const QString &crashDirectory)
+        : Event(parent, "Apport")
+        , m_crashDirectory(crashDirectory)
+        , m_coalescer(nullptr)
+        , m_burst(readCrashBurstWindow())
+        , m_burstTimer(nullptr)
+        , m_upload(nullptr)
+        , m_uploadRunning(false)
+        , m_uploadQueued(false)
+        , m_uploadedCount(0)
+        , m_lastUploadedCount(0)
+        , m_lastUploadDuration(0)
+        , m_lastUploadExitCode(0)
+        , m_uploadRuns(0)
+{
     qDebug() << "Using ApportEvent";
 
-    auto apportDirWatch =  new KDirWatch(this);
-    apportDirWatch->addDir("/var/crash/");
-    connect(apportDirWatch, &KDirWatch::dirty, this, &ApportEvent::onDirty);
+    // Apport writes report and stamps in quick succession, look at them
+    // together once things calmed down.
+    m_coalescer = new Coalescer(1000, 5000, this);
+    connect(m_coalescer, &Coalescer::triggered, this, &ApportEvent::onChangesSettled);
+
+    FileWatcher *watcher = FileWatcher::self();
+    watcher->addDirectory(m_crashDirectory);
+    connect(watcher, &FileWatcher::changed, this, &ApportEvent::onFileChanged);
+    connect(watcher, &FileWatcher::overflowed, m_coalescer, [this] { m_coalescer->add(); });
+
+    m_clock.start();
+    m_burstTimer = new QTimer(this);
+    m_burstTimer->setSingleShot(true);
+    m_burstTimer->setInterval(m_burst.window());
+    connect(m_burstTimer, &QTimer::timeout, this, &ApportEvent::onBurstOver);
+
+    // Known state of the crash directory, kept current by file events.
+    m_states = CrashFile::scan(m_crashDirectory, &m_inodes);
 
     // Force check, we just started up and there might have been crashes on reboot
     show();
@@ -52,6 +115,12 @@ ApportEvent::ApportEvent(QObject* parent)
 
 ApportEvent::~ApportEvent()
 {
+    if (m_uploadRunning) {
+        // Destroying the QProcess kills the upload, which must not be cut
+        // off by kded exiting. Let go of it instead.
+        m_upload->disconnect(this);
+        m_upload->setParent(nullptr);
+    }
 }
 
 bool ApportEvent::reportsAvailable()
@@ -59,16 +128,16 @@ bool ApportEvent::reportsAvailable()
 // TODO: there is also a --system arg for checkreports, update-notifier does seem to use
 //       that in an either-or combo... so question is why does that --system arg exist at
 //       all if we are supposed to either-or the results of two runs anyway?
-    KProcess *apportProcess = new KProcess();
-    apportProcess->setProgram(QStringList() << "/usr/share/apport/apport-checkreports");
-
-    if (apportProcess->execute() == 0) {
-        return true;
-    }
-    return false;
+    // Same rules as /usr/share/apport/apport-checkreports, minus the python startup.
+    return CrashReports(m_crashDirectory).reportsAvailable();
 }
 
 void ApportEvent::show()
+{
+    showCrashes(1);
+}
+
+void ApportEvent::showCrashes(int count, const QString &application)
 {
     if (isHidden()) {
         return;
@@ -82,6 +151,15 @@ void ApportEvent::show()
     QString icon = QString("apport");
     QString text(i18nc("Notification when apport detects a crash",
                        "An application has crashed on your system (now or in the past)"));
+    if (count == 1 && !application.isEmpty()) {
+        text = i18nc("Notification when apport detects a crash of a known application",
+                     "%1 has crashed on your system", application);
+    } else if (count > 1) {
+        text = i18ncp("Notification when apport detected repeated crashes in a short time",
+                      "An application has crashed %1 time on your system",
+                      "Applications have crashed %1 times on your system",
+                      count);
+    }
     QStringList actions;
     actions << i18nc("Opens a dialog with more details", "Details");
     actions << i18nc("Button to dismiss this notification once", "Ignore for now");
@@ -93,14 +171,61 @@ void ApportEvent::show()
 
 void ApportEvent::batchUploadAllowed()
 {
-    const QString script = QStandardPaths::locate(QStandardPaths::GenericDataLocation,
-                                                  "kubuntu-notification-helper/whoopsie-upload-all");
-    if (script.isEmpty()) {
+    if (m_uploadRunning) {
+        // Single flight. The running job may have collected its reports
+        // already, so anything accepted meanwhile gets one follow-up run.
+        qDebug() << "upload running, queueing follow-up";
+        m_uploadQueued = true;
+        return;
+    }
+
+    if (m_uploadScript.isEmpty()) {
+        m_uploadScript = QStandardPaths::locate(QStandardPaths::GenericDataLocation,
+                                                "kubuntu-notification-helper/whoopsie-upload-all");
+    }
+    if (m_uploadScript.isEmpty()) {
         qWarning() << "ApportEvent: whoopsie-upload-all not found";
         return;
     }
-    qDebug() << "running" << script;
-    KToolInvocation::kdeinitExec(script);
+
+    qDebug() << "running" << m_uploadScript;
+    m_uploadQueued = false;
+    if (!m_upload) {
+        m_upload = new SessionProcess(this);
+        // Nobody reads its output.
+        m_upload->setProcessChannelMode(QProcess::ForwardedChannels);
+        connect(m_upload, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                this, &ApportEvent::onUploadFinished);
+        connect(m_upload, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart) {
+                qWarning() << "ApportEvent: failed to start" << m_uploadScript;
+                m_uploadRunning = false;
+            }
+        });
+    }
+    m_uploadRunning = true;
+    m_uploadedCount = 0;
+    m_uploadTime.start();
+    m_upload->start(m_uploadScript, QStringList());
+}
+
+void ApportEvent::onUploadFinished()
+{
+    // Reports marked uploaded while it ran tell what it did.
+    m_uploadRunning = false;
+    m_lastUploadedCount = m_uploadedCount;
+    m_lastUploadDuration = m_uploadTime.elapsed();
+    m_lastUploadExitCode = m_upload->exitStatus() == QProcess::NormalExit ? m_upload->exitCode() : -1;
+    ++m_uploadRuns;
+    qDebug() << "upload finished" << "exit code" << m_lastUploadExitCode
+             << "uploaded" << m_lastUploadedCount
+             << "duration(ms)" << m_lastUploadDuration
+             << "runs" << m_uploadRuns;
+
+    if (m_uploadQueued) {
+        // Not from within the finished() emission of the same process.
+        QTimer::singleShot(0, this, &ApportEvent::batchUploadAllowed);
+    }
 }
 
 void ApportEvent::run()
@@ -113,51 +238,174 @@ void ApportEvent::apportDirEvent()
 {
     qDebug();
 
-    QDir dir(QLatin1String("/var/crash"));
-    dir.setNameFilters(QStringList() << QLatin1String("*.crash"));
+    // Full rescan, events got lost. Diff against what we knew.
+    QHash<QString, quint64> inodes;
+    const CrashFile::StateMap states = CrashFile::scan(m_crashDirectory, &inodes);
+    for (auto it = m_states.constBegin(); it != m_states.constEnd(); ++it) {
+        if (!m_before.contains(it.key())) {
+            m_before.insert(it.key(), it.value());
+        }
+    }
+    for (auto it = states.constBegin(); it != states.constEnd(); ++it) {
+        if (!m_before.contains(it.key())) {
+            m_before.insert(it.key(), CrashFile::State());
+        }
+    }
+    m_states = states;
+    m_inodes = inodes;
+
+    evaluateChanges(m_before.keys());
+}
+
+void ApportEvent::onFileChanged(const QString &path, FileWatcher::Change change)
+{
+    if (!path.startsWith(m_crashDirectory + QLatin1Char('/'))) {
+        return;
+    }
 
+    QString stem;
+    const CrashFile::StateFlag flag = CrashFile::classify(path, &stem);
+    if (!flag) {
+        return;
+    }
+    // Reports are only interesting once fully written, stamps as soon as
+    // they exist.
+    if (flag == CrashFile::Crash && change == FileWatcher::Created) {
+        return;
+    }
+    // An unreadable report is as good as gone.
+    if (flag == CrashFile::Crash && change != FileWatcher::Deleted &&
+        !CrashFile::isReadable(path)) {
+        change = FileWatcher::Deleted;
+    }
+    if (flag == CrashFile::Uploaded && m_uploadRunning &&
+        (change == FileWatcher::Created || change == FileWatcher::MovedIn)) {
+        ++m_uploadedCount;
+    }
+
+    if (flag == CrashFile::Crash) {
+        if (change == FileWatcher::Deleted) {
+            m_inodes.remove(stem);
+            m_dates.remove(stem);
+        } else if (isNewCrash(stem, path)) {
+            // Repeats of the same executable within a burst are only
+            // counted, see onBurstOver().
+            if (!m_burst.record(CrashBurst::executableForStem(stem), m_clock.elapsed())) {
+                m_repeats.insert(stem);
+            }
+            m_burstTimer->start();
+        }
+    }
+
+    if (!m_before.contains(stem)) {
+        m_before.insert(stem, m_states.value(stem));
+    }
+
+    CrashFile::State state = m_states.value(stem);
+    if (change == FileWatcher::Deleted) {
+        state &= ~flag;
+    } else {
+        state |= flag;
+    }
+    if (state) {
+        m_states.insert(stem, state);
+    } else {
+        m_states.remove(stem);
+    }
+
+    m_coalescer->add(stem);
+}
+
+bool ApportEvent::isNewCrash(const QString &stem, const QString &path)
+{
+    // whoopsie-upload-all and the apport UI append to existing reports,
+    // only a new file carrying a different crash Date is another crash.
+    struct stat info;
+    if (stat(QFile::encodeName(path).constData(), &info) != 0) {
+        return false;
+    }
+    const bool known = m_inodes.contains(stem);
+    if (known && m_inodes.value(stem) == quint64(info.st_ino)) {
+        return false;
+    }
+    m_inodes.insert(stem, info.st_ino);
+
+    const QString date = CrashHeader::read(path).date;
+    const QString knownDate = m_dates.value(stem);
+    m_dates.insert(stem, date);
+    return !known || knownDate.isNull() || knownDate != date;
+}
+
+void ApportEvent::onChangesSettled(const QStringList &stems)
+{
+    if (stems.isEmpty()) {
+        apportDirEvent();
+        return;
+    }
+    evaluateChanges(stems);
+}
+
+void ApportEvent::evaluateChanges(const QStringList &stems)
+{
+    // One upload run and one notification for the whole burst, and only
+    // for stems which actually changed state.
     bool foundCrashFile = false;
     bool foundAutoUpload = false;
-    foreach (const QFileInfo &fileInfo, dir.entryInfoList()) {
-        CrashFile f(fileInfo);
-        if (f.isAutoUploadAllowed())
-            foundAutoUpload = true;
-            continue;
-        if (f.isValid()) {
-            foundCrashFile = true;
+    QStringList newCrashes;
+    foreach (const QString &stem, stems) {
+        const QString path = stem + QLatin1String(".crash");
+        const CrashFile before(path, m_before.take(stem));
+        const CrashFile after(path, m_states.value(stem));
+        if (before.state() == after.state()) {
             continue;
         }
+
+        if (after.isAutoUploadAllowed() && (after.state() & CrashFile::Crash) &&
+            !(after.state() & CrashFile::Upload) &&
+            !(before.isAutoUploadAllowed() && (before.state() & CrashFile::Crash))) {
+            foundAutoUpload = true; // newly accepted for upload
+        } else if (!after.isAutoUploadAllowed() && after.isValid() && !before.isValid() &&
+                   !m_repeats.contains(stem)) {
+            foundCrashFile = true; // new valid crash
+            newCrashes << path;
+        }
     }
+    m_before.clear();
+    m_repeats.clear();
 
     qDebug() << "foundCrashFile" << foundCrashFile
              << "foundAutoUpload" << foundAutoUpload;
 
+    if (isHidden()) {
+        return;
+    }
+
     if (foundAutoUpload) {
         batchUploadAllowed();
     }
 
     if (foundCrashFile) {
-        show();
+        QString application;
+        if (newCrashes.size() == 1) {
+            // Only the leading headers, never the core dump.
+            application = CrashHeader::read(newCrashes.first()).applicationName();
+        }
+        showCrashes(newCrashes.size(), application);
     }
 }
 
-void ApportEvent::onDirty(const QString &path)
+void ApportEvent::onBurstOver()
 {
-    if (isHidden()) {
-        return;
-    }
+    qDebug() << "crashes" << m_burst.crashCount()
+             << "suppressed" << m_burst.suppressedCount()
+             << "executables" << m_burst.executableCount();
 
-    qDebug() << path;
-    if (path.isEmpty()) { // Check whole directory for possible crash files.
-        apportDirEvent();
-        return;
-    }
-
-    // Check param path for validity.
-    CrashFile f(path);
-    if (f.isAutoUploadAllowed()) {
-        batchUploadAllowed();
-    } else if (f.isValid()) {
-        show();
+    // The first crash of every executable was surfaced right away, if there
+    // were repeats surface a single summary with the full count.
+    const int crashes = m_burst.crashCount();
+    const bool hadRepeats = m_burst.suppressedCount() > 0;
+    m_burst.reset();
+    if (hadRepeats) {
+        showCrashes(crashes);
     }
 }
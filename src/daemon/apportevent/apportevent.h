@@ -23,64 +23,83 @@
 #define APPORTEVENT_H
 
 #include "../event.h"
+#include "../filewatcher.h"
 
-#include <QtCore/QFileInfo>
+#include "crashburst.h"
+#include "crashfile.h"
 
-class CrashFile
-{
-public:
-    CrashFile(const QString &path)
-        : m_path(path)
-        , m_info(QFileInfo(path))
-    {
-    }
-
-    CrashFile(const QFileInfo &info)
-        : m_path(info.absoluteFilePath())
-        , m_info(info)
-    {
-    }
-
-    bool isAutoUploadAllowed() const {
-        QString acceptPath = m_path;
-        acceptPath.replace(QLatin1String(".crash"), QLatin1String(".drkonqi-accept"));
-        return QFile(acceptPath).exists();
-    }
-
-    bool isValid() const {
-        QString uploadPath = m_path; // Marked for upload -> ignore.
-        uploadPath.replace(QLatin1String(".crash"), QLatin1String(".upload"));
-        QString uploadedPath = m_path; // Alraedy uploaded -> ignore even more.
-        uploadedPath.replace(QLatin1String(".crash"), QLatin1String(".uploaded"));
-        return (!QFile(uploadPath).exists() &&
-                !QFile(uploadedPath).exists() &&
-                ((m_info.suffix() == QLatin1String("crash")) &&
-                 (m_info.permission(QFile::ReadUser))));
-    }
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSet>
 
-private:
-    QString m_path;
-    QFileInfo m_info;
-};
+class QProcess;
+class QTimer;
+
+class Coalescer;
 
 class ApportEvent : public Event
 {
     Q_OBJECT
 public:
-    ApportEvent(QObject* parent);
+    /**
+     * @param crashDirectory where apport puts its reports, tests use a
+     *        sandbox
+     */
+    ApportEvent(QObject* parent, const QString &crashDirectory = QStringLiteral("/var/crash"));
 
     virtual ~ApportEvent();
 
+    /** Whether an apport frontend is installed, no point in watching otherwise. */
+    static bool isAvailable();
+
 public slots:
     void show();
+    void showCrashes(int count, const QString &application = QString());
     void batchUploadAllowed();
 
 private slots:
     bool reportsAvailable();
     void run();
-    void onDirty(const QString &path);
+    void onFileChanged(const QString &path, FileWatcher::Change change);
+    void onChangesSettled(const QStringList &stems);
+    void onBurstOver();
+    void onUploadFinished();
 private:
+    friend class ApportEventTest;
+
     void apportDirEvent();
+    void evaluateChanges(const QStringList &stems);
+    bool isNewCrash(const QString &stem, const QString &path);
+
+    const QString m_crashDirectory;
+    Coalescer *m_coalescer;
+    // Stem -> state as currently on disk.
+    CrashFile::StateMap m_states;
+    // Stem -> state before the changes not yet evaluated.
+    CrashFile::StateMap m_before;
+    // Stem -> inode and Date header of the report, tells reports appended
+    // to or rewritten from new crashes.
+    QHash<QString, quint64> m_inodes;
+    QHash<QString, QString> m_dates;
+
+    // Crash loop suppression.
+    CrashBurst m_burst;
+    QTimer *m_burstTimer;
+    QElapsedTimer m_clock;
+    // Stems rewritten by a repeat crash since the last evaluation.
+    QSet<QString> m_repeats;
+
+    // whoopsie-upload-all job, at most one at a time. It runs in a session
+    // of its own so it survives kded.
+    QString m_uploadScript;
+    QProcess *m_upload;
+    bool m_uploadRunning;
+    bool m_uploadQueued;
+    QElapsedTimer m_uploadTime;
+    int m_uploadedCount;
+    int m_lastUploadedCount;
+    qint64 m_lastUploadDuration;
+    int m_lastUploadExitCode;
+    int m_uploadRuns;
 };
 
 #endif
@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "crashburst.h"
+
+CrashBurst::CrashBurst(qint64 windowMs)
+    : m_window(windowMs)
+    , m_last(0)
+    , m_crashes(0)
+    , m_suppressed(0)
+{
+}
+
+bool CrashBurst::record(const QString &executable, qint64 nowMs)
+{
+    if (m_crashes > 0 && isOver(nowMs)) {
+        reset();
+    }
+
+    m_last = nowMs;
+    ++m_crashes;
+
+    int &count = m_executables[executable];
+    if (count++ > 0) {
+        ++m_suppressed;
+        return false;
+    }
+    return true;
+}
+
+bool CrashBurst::isOver(qint64 nowMs) const
+{
+    return nowMs - m_last >= m_window;
+}
+
+void CrashBurst::reset()
+{
+    m_last = 0;
+    m_crashes = 0;
+    m_suppressed = 0;
+    m_executables.clear();
+}
+
+QString CrashBurst::executableForStem(const QString &stem)
+{
+    // Reports are named <mangled executable path>.<uid>.crash
+    const int slash = stem.lastIndexOf(QLatin1Char('/'));
+    const int dot = stem.lastIndexOf(QLatin1Char('.'));
+    if (dot <= slash + 1) {
+        return stem.mid(slash + 1);
+    }
+    return stem.mid(slash + 1, dot - slash - 1);
+}
@@ -0,0 +1,73 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef CRASHBURST_H
+#define CRASHBURST_H
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+/**
+ * Groups crashes arriving in quick succession (e.g. a service stuck in a
+ * crash loop) into bursts.
+ *
+ * A burst lasts as long as crashes keep arriving within the window of the
+ * previous one. Within a burst only the first crash of every executable is
+ * worth surfacing, repeats are merely counted.
+ */
+class CrashBurst
+{
+public:
+    explicit CrashBurst(qint64 windowMs);
+
+    /**
+     * Records a crash of @p executable at @p nowMs (monotonic).
+     * @return true if this is the first crash of @p executable in the
+     *         current burst, false if it is a repeat and should be suppressed
+     */
+    bool record(const QString &executable, qint64 nowMs);
+
+    /** @return whether the burst ended, i.e. no crash for a full window */
+    bool isOver(qint64 nowMs) const;
+
+    /** Ends the current burst. */
+    void reset();
+
+    /** @return number of crashes in the current burst, repeats included */
+    int crashCount() const { return m_crashes; }
+    /** @return number of crashes which were suppressed as repeats */
+    int suppressedCount() const { return m_suppressed; }
+    /** @return number of distinct executables in the current burst */
+    int executableCount() const { return m_executables.size(); }
+
+    qint64 window() const { return m_window; }
+
+    /** @return executable key of the report with the given stem */
+    static QString executableForStem(const QString &stem);
+
+private:
+    qint64 m_window;
+    qint64 m_last;
+    int m_crashes;
+    int m_suppressed;
+    QHash<QString, int> m_executables;
+};
+
+#endif // CRASHBURST_H
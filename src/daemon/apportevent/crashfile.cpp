@@ -0,0 +1,110 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "crashfile.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <dirent.h>
+
+CrashFile::CrashFile(const QString &path, State state)
+    : m_path(path)
+    , m_state(state)
+{
+}
+
+bool CrashFile::isAutoUploadAllowed() const
+{
+    return m_state & Accept;
+}
+
+bool CrashFile::isValid() const
+{
+    // Marked for upload -> ignore. Already uploaded -> ignore even more.
+    return (m_state & Crash) && !(m_state & (Upload | Uploaded));
+}
+
+CrashFile::StateFlag CrashFile::classify(const QString &fileName, QString *stem)
+{
+    const int dot = fileName.lastIndexOf(QLatin1Char('.'));
+    if (dot <= fileName.lastIndexOf(QLatin1Char('/')) + 1) {
+        return StateFlag(0); // no suffix or hidden file
+    }
+    const QStringRef suffix = fileName.midRef(dot + 1);
+
+    StateFlag flag;
+    if (suffix == QLatin1String("crash")) {
+        flag = Crash;
+    } else if (suffix == QLatin1String("upload")) {
+        flag = Upload;
+    } else if (suffix == QLatin1String("uploaded")) {
+        flag = Uploaded;
+    } else if (suffix == QLatin1String("drkonqi-accept")) {
+        flag = Accept;
+    } else {
+        return StateFlag(0);
+    }
+
+    if (stem) {
+        *stem = fileName.left(dot);
+    }
+    return flag;
+}
+
+bool CrashFile::isReadable(const QString &path)
+{
+    return QFileInfo(path).permission(QFile::ReadUser);
+}
+
+CrashFile::StateMap CrashFile::scan(const QString &directory, QHash<QString, quint64> *inodes)
+{
+    StateMap states;
+
+    // Plain readdir: one pass over the directory, no stat per entry.
+    DIR *dir = opendir(QFile::encodeName(directory).constData());
+    if (!dir) {
+        return states;
+    }
+
+    const QString prefix = directory.endsWith(QLatin1Char('/')) ? directory
+                                                                : directory + QLatin1Char('/');
+    QString stem;
+    while (struct dirent *entry = readdir(dir)) {
+        if (entry->d_type != DT_REG && entry->d_type != DT_UNKNOWN) {
+            continue;
+        }
+        StateFlag flag = classify(QFile::decodeName(entry->d_name), &stem);
+        // One stat per report, stamps are many more and only their name
+        // matters.
+        if (flag == Crash && !isReadable(prefix + stem + QLatin1String(".crash"))) {
+            flag = StateFlag(0);
+        }
+        if (flag) {
+            states[prefix + stem] |= flag;
+        }
+        if (flag == Crash && inodes) {
+            inodes->insert(prefix + stem, entry->d_ino);
+        }
+    }
+
+    closedir(dir);
+    return states;
+}
@@ -0,0 +1,78 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef CRASHFILE_H
+#define CRASHFILE_H
+
+#include <QtCore/QFlags>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+/**
+ * A crash report in the crash directory, classified by which of its sibling
+ * files (same stem, different suffix) exist.
+ */
+class CrashFile
+{
+public:
+    enum StateFlag {
+        Crash = 0x1,    ///< the .crash report itself (readable)
+        Upload = 0x2,   ///< marked for whoopsie upload
+        Uploaded = 0x4, ///< uploaded by whoopsie
+        Accept = 0x8    ///< user accepted upload via drkonqi
+    };
+    Q_DECLARE_FLAGS(State, StateFlag)
+
+    /** stem (absolute path without suffix) -> state */
+    typedef QHash<QString, State> StateMap;
+
+    /** Classifies the report at @p path by a known @p state, no IO. */
+    CrashFile(const QString &path, State state);
+
+    bool isAutoUploadAllowed() const;
+    bool isValid() const;
+
+    QString path() const { return m_path; }
+    State state() const { return m_state; }
+
+    /**
+     * Reads @p directory once and groups its entries by stem. Reports only
+     * count as Crash when readable, stamps are taken by name.
+     * @param inodes if not null, filled with stem -> inode of each report
+     */
+    static StateMap scan(const QString &directory, QHash<QString, quint64> *inodes = nullptr);
+
+    /**
+     * @return the flag for the suffix of @p fileName (0 if irrelevant) and
+     *         the stem in @p stem
+     */
+    static StateFlag classify(const QString &fileName, QString *stem);
+
+    /** Whether the report at @p path may be read by its owner. */
+    static bool isReadable(const QString &path);
+
+private:
+    QString m_path;
+    State m_state;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(CrashFile::State)
+
+#endif // CRASHFILE_H
@@ -0,0 +1,153 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "crashheader.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <string.h>
+
+QString CrashHeader::applicationName() const
+{
+    if (!executablePath.isEmpty()) {
+        return QFileInfo(executablePath).fileName();
+    }
+    // "firefox 95.0+build1-0ubuntu1" -> "firefox"
+    return package.section(QLatin1Char(' '), 0, 0);
+}
+
+// Handles the line from @p line to @p eol (exclusive).
+// @return false once there is nothing more to find.
+static bool parseLine(CrashHeader &header, const char *line, const char *eol)
+{
+    if (line < eol && (*line == ' ' || *line == '\t')) {
+        return true; // continuation of a field we do not care about
+    }
+    const char *colon = static_cast<const char *>(memchr(line, ':', eol - line));
+    if (!colon) {
+        return false; // not a report
+    }
+
+    const QByteArray key = QByteArray::fromRawData(line, colon - line);
+    const char *valueStart = colon + 1;
+    while (valueStart < eol && *valueStart == ' ') {
+        ++valueStart;
+    }
+    const QByteArray value = QByteArray::fromRawData(valueStart, eol - valueStart);
+    if (value == "base64") {
+        return false; // binary blobs come after all text fields
+    }
+
+    QString *target = nullptr;
+    if (key == "ProblemType") {
+        target = &header.problemType;
+    } else if (key == "ExecutablePath") {
+        target = &header.executablePath;
+    } else if (key == "Package") {
+        target = &header.package;
+    } else if (key == "Date") {
+        target = &header.date;
+    }
+    if (target && target->isNull()) {
+        *target = QString::fromUtf8(value.constData(), value.size());
+    }
+
+    if (header.problemType.isNull() || header.package.isNull() || header.date.isNull()) {
+        return true;
+    }
+    // Only crashes have an executable, package problems and the like end
+    // here.
+    return header.problemType == QLatin1String("Crash") && header.executablePath.isNull();
+}
+
+// Continues parsing from the current position of @p file without holding
+// more than one buffer of it, reading at most @p budget bytes. Overlong
+// lines are only looked at up to the buffer size, which is plenty for the
+// fields we want.
+static void parseStream(CrashHeader &header, QFile &file, qint64 budget)
+{
+    char buffer[4096];
+    bool skipping = false; // rest of an overlong line
+    while (budget > 0) {
+        const qint64 length = file.readLine(buffer, qMin<qint64>(sizeof(buffer), budget + 1));
+        if (length <= 0) {
+            return;
+        }
+        budget -= length;
+        const bool complete = buffer[length - 1] == '\n';
+        if (!skipping && !parseLine(header, buffer, buffer + (complete ? length - 1 : length))) {
+            return;
+        }
+        skipping = !complete;
+    }
+}
+
+CrashHeader CrashHeader::read(const QString &path, qint64 limit, qint64 scanLimit)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly)) {
+        return CrashHeader();
+    }
+    const qint64 size = qMin(file.size(), limit);
+    if (size <= 0) {
+        return CrashHeader();
+    }
+    const uchar *data = file.map(0, size);
+    if (!data) {
+        return CrashHeader();
+    }
+    qint64 consumed = -1;
+    CrashHeader header = parse(reinterpret_cast<const char *>(data), size, &consumed);
+    file.unmap(const_cast<uchar *>(data));
+
+    if (consumed >= 0 && size < file.size() && consumed < scanLimit && file.seek(consumed)) {
+        // Limit reached with fields still missing, long text fields sorted
+        // before them.
+        parseStream(header, file, scanLimit - consumed);
+    }
+    return header;
+}
+
+CrashHeader CrashHeader::parse(const char *data, qint64 size, qint64 *consumed)
+{
+    CrashHeader header;
+
+    const char *end = data + size;
+    const char *line = data;
+    while (line < end) {
+        const char *eol = static_cast<const char *>(memchr(line, '\n', end - line));
+        if (!eol) {
+            break; // truncated by the limit, the line may be incomplete
+        }
+        if (!parseLine(header, line, eol)) {
+            if (consumed) {
+                *consumed = -1;
+            }
+            return header;
+        }
+        line = eol + 1;
+    }
+
+    if (consumed) {
+        *consumed = line - data;
+    }
+    return header;
+}
@@ -0,0 +1,73 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef CRASHHEADER_H
+#define CRASHHEADER_H
+
+#include <QtCore/QString>
+
+/**
+ * Leading key/value headers of an apport report.
+ *
+ * Apport writes ProblemType first, then the text fields sorted by key and
+ * binary blobs such as CoreDump last. The fields needed for a short summary
+ * are usually within the first few KiB, but long text fields sorting before
+ * them (Dependencies, Disassembly, DpkgTerminalLog, ...) can push them much
+ * further. The binary blobs are never read either way.
+ */
+struct CrashHeader
+{
+    QString problemType;
+    QString executablePath;
+    QString package;
+    QString date;
+
+    bool isValid() const { return !problemType.isEmpty(); }
+
+    /**
+     * @return a user presentable application name, derived from the
+     *         executable or the package
+     */
+    QString applicationName() const;
+
+    /**
+     * Memory maps at most @p limit bytes of the report at @p path and parses
+     * them. If the fields are not all found within @p limit the text fields
+     * are scanned on line by line with a fixed size buffer, stopping at the
+     * first binary value and after @p scanLimit bytes in total. Fields
+     * beyond that are reported absent.
+     *
+     * Parsing ends once ProblemType, Date and Package are known, and for
+     * crashes ExecutablePath.
+     */
+    static CrashHeader read(const QString &path, qint64 limit = 16 * 1024,
+                            qint64 scanLimit = 256 * 1024);
+
+    /**
+     * Parses headers from @p data, stopping at the first binary value.
+     * @param consumed if not null, set to the size of the complete lines
+     *        parsed when @p data ended before parsing was done, or to -1
+     *        when it was done (fields found, binary value reached or not a
+     *        report)
+     */
+    static CrashHeader parse(const char *data, qint64 size, qint64 *consumed = nullptr);
+};
+
+#endif // CRASHHEADER_H
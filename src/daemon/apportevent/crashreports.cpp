@@ -0,0 +1,80 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "crashreports.h"
+#include "crashfile.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+#include <unistd.h>
+
+CrashReports::CrashReports(const QString &directory, const QString &apportConfig)
+    : m_directory(directory)
+    , m_apportConfig(apportConfig)
+{
+}
+
+QStringList CrashReports::newReports() const
+{
+    QStringList reports;
+
+    const uint uid = ::getuid();
+    const CrashFile::StateMap states = CrashFile::scan(m_directory);
+    for (auto it = states.constBegin(); it != states.constEnd(); ++it) {
+        const CrashFile crash(it.key() + QLatin1String(".crash"), it.value());
+        if (!crash.isValid()) {
+            continue; // no report, or marked for/done with upload
+        }
+        const QFileInfo info(crash.path());
+        if (!info.isFile() || info.size() <= 0 || info.ownerId() != uid ||
+            !info.isReadable() || !info.isWritable()) {
+            continue;
+        }
+        // apport marks reports as seen by reading them.
+        if (info.lastRead() > info.lastModified()) {
+            continue;
+        }
+        reports << info.absoluteFilePath();
+    }
+
+    reports.sort();
+    return reports;
+}
+
+bool CrashReports::reportsAvailable() const
+{
+    return isApportEnabled() && !newReports().isEmpty();
+}
+
+bool CrashReports::isApportEnabled() const
+{
+    // Same check as apport.packaging enabled(): a missing config means
+    // enabled, only an explicit enabled=0 disables.
+    QFile config(m_apportConfig);
+    if (!config.open(QFile::ReadOnly)) {
+        return true;
+    }
+    static const QRegularExpression disabled(QStringLiteral("^\\s*enabled\\s*=\\s*0\\s*$"),
+                                             QRegularExpression::MultilineOption);
+    return !disabled.match(QString::fromUtf8(config.readAll())).hasMatch();
+}
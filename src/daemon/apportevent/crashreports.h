@@ -0,0 +1,60 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef CRASHREPORTS_H
+#define CRASHREPORTS_H
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+/**
+ * Native equivalent of apport-checkreports.
+ *
+ * Applies the rules of apport.fileutils.get_new_reports() to the crash
+ * directory without starting a Python interpreter:
+ *  - only non-empty *.crash files
+ *  - owned by, readable and writable for the calling user
+ *  - not yet seen (atime not newer than mtime)
+ *  - not marked for or done with whoopsie upload (.upload/.uploaded stamp)
+ */
+class CrashReports
+{
+public:
+    explicit CrashReports(const QString &directory = QStringLiteral("/var/crash"),
+                          const QString &apportConfig = QStringLiteral("/etc/default/apport"));
+
+    /** @return new reports for the calling user */
+    QStringList newReports() const;
+
+    /**
+     * @return whether apport-checkreports would exit successfully, i.e.
+     *         there are new reports and apport is enabled
+     */
+    bool reportsAvailable() const;
+
+    /** @return false if apport got disabled in its config */
+    bool isApportEnabled() const;
+
+private:
+    QString m_directory;
+    QString m_apportConfig;
+};
+
+#endif // CRASHREPORTS_H
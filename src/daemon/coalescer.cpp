@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "coalescer.h"
+
+#include <QTimer>
+
+Coalescer::Coalescer(int quietMs, int maxDelayMs, QObject *parent)
+    : QObject(parent)
+    , m_quietTimer(new QTimer(this))
+    , m_maxTimer(new QTimer(this))
+    , m_pending(false)
+    , m_everything(false)
+{
+    m_quietTimer->setSingleShot(true);
+    m_quietTimer->setInterval(quietMs);
+    connect(m_quietTimer, &QTimer::timeout, this, &Coalescer::flush);
+
+    m_maxTimer->setSingleShot(true);
+    m_maxTimer->setInterval(maxDelayMs);
+    connect(m_maxTimer, &QTimer::timeout, this, &Coalescer::flush);
+}
+
+Coalescer::~Coalescer()
+{
+}
+
+void Coalescer::add(const QString &path)
+{
+    if (path.isEmpty()) {
+        m_everything = true;
+        m_paths.clear(); // moot now
+    } else if (!m_everything) {
+        m_paths.insert(path);
+    }
+
+    if (!m_pending) {
+        m_pending = true;
+        m_maxTimer->start();
+    }
+    m_quietTimer->start();
+}
+
+void Coalescer::flush()
+{
+    m_quietTimer->stop();
+    m_maxTimer->stop();
+    if (!m_pending) {
+        return;
+    }
+
+    QStringList paths;
+    if (!m_everything) {
+        paths = m_paths.values();
+        paths.sort();
+    }
+    m_paths.clear();
+    m_pending = false;
+    m_everything = false;
+
+    emit triggered(paths);
+}
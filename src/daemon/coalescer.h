@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef COALESCER_H
+#define COALESCER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+class QTimer;
+
+/**
+ * Merges bursts of file changes into a single recheck.
+ *
+ * Every add() restarts a quiet window; once nothing was added for that long
+ * triggered() is emitted with the union of all added paths. A maximum delay
+ * bounds the wait for changes which never calm down (e.g. a long running
+ * dpkg session).
+ */
+class Coalescer : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @param quietMs how long no changes may arrive before triggering
+     * @param maxDelayMs upper bound between the first change and triggering
+     */
+    Coalescer(int quietMs, int maxDelayMs, QObject *parent = nullptr);
+    virtual ~Coalescer();
+
+public Q_SLOTS:
+    /** Queues @p path. An empty path requests a full rescan. */
+    void add(const QString &path = QString());
+    /** Triggers right away if anything is queued. */
+    void flush();
+
+Q_SIGNALS:
+    /**
+     * @param paths sorted union of the changed paths, empty when a full
+     *        rescan was requested
+     */
+    void triggered(const QStringList &paths);
+
+private:
+    QTimer *m_quietTimer;
+    QTimer *m_maxTimer;
+    QSet<QString> m_paths;
+    bool m_pending;
+    bool m_everything;
+};
+
+#endif // COALESCER_H
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "dpkgstatus.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+
+#include <string.h>
+
+DpkgStatus::DpkgStatus(const QString &path)
+    : m_path(path)
+    , m_size(-1)
+{
+}
+
+bool DpkgStatus::isInstalled(const QString &package) const
+{
+    return m_installed.contains(package);
+}
+
+bool DpkgStatus::refresh()
+{
+    const QFileInfo info(m_path);
+    if (m_size == info.size() && m_mtime == info.lastModified()) {
+        return false;
+    }
+    m_size = info.size();
+    m_mtime = info.lastModified();
+    m_installed.clear();
+
+    QFile file(m_path);
+    if (!file.open(QFile::ReadOnly)) {
+        qWarning() << "DpkgStatus: cannot open" << m_path;
+        return true;
+    }
+    const qint64 size = file.size();
+    if (size <= 0) {
+        return true;
+    }
+    const uchar *data = file.map(0, size);
+    if (!data) {
+        qWarning() << "DpkgStatus: cannot map" << m_path;
+        return true;
+    }
+    parse(reinterpret_cast<const char *>(data), size);
+    file.unmap(const_cast<uchar *>(data));
+    return true;
+}
+
+void DpkgStatus::clear()
+{
+    m_installed.clear();
+    m_installed.squeeze();
+    m_size = -1;
+    m_mtime = QDateTime();
+}
+
+static bool startsWith(const char *line, const char *end, const char *field, int fieldLength)
+{
+    return end - line > fieldLength && memcmp(line, field, fieldLength) == 0;
+}
+
+void DpkgStatus::parse(const char *data, qint64 size)
+{
+    const char *end = data + size;
+
+    const char *package = nullptr;
+    int packageLength = 0;
+    const char *arch = nullptr;
+    int archLength = 0;
+    bool installed = false;
+
+    auto commit = [&]() {
+        if (package && installed) {
+            const QString name = QString::fromLatin1(package, packageLength);
+            m_installed.insert(name);
+            if (arch && !(archLength == 3 && memcmp(arch, "all", 3) == 0)) {
+                m_installed.insert(name + QLatin1Char(':') + QString::fromLatin1(arch, archLength));
+            }
+        }
+        package = nullptr;
+        arch = nullptr;
+        installed = false;
+    };
+
+    for (const char *line = data; line < end; ) {
+        const char *eol = static_cast<const char *>(memchr(line, '\n', end - line));
+        if (!eol) {
+            eol = end;
+        }
+
+        if (eol == line) {
+            commit(); // stanza separator
+        } else if (startsWith(line, eol, "Package: ", 9)) {
+            package = line + 9;
+            packageLength = eol - package;
+        } else if (startsWith(line, eol, "Architecture: ", 14)) {
+            arch = line + 14;
+            archLength = eol - arch;
+        } else if (startsWith(line, eol, "Status: ", 8)) {
+            // "want flag status", dpkg knows the package (and apt has a
+            // current version) unless it is not-installed or config-files.
+            const char *status = static_cast<const char *>(memrchr(line, ' ', eol - line)) + 1;
+            const QByteArray state = QByteArray::fromRawData(status, eol - status);
+            installed = state != "not-installed" && state != "config-files";
+        }
+
+        line = eol + 1;
+    }
+    commit();
+}
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef DPKGSTATUS_H
+#define DPKGSTATUS_H
+
+#include <QtCore/QDateTime>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+/**
+ * Lightweight index of installed packages built from the dpkg status file.
+ *
+ * This is a fraction of the cost of a QApt::Backend for answering "is
+ * package X installed". The status file is memory mapped and parsed in one
+ * pass, lookups are hash lookups. refresh() rebuilds the index if the
+ * status file changed, call it once per check before looking packages up.
+ *
+ * Packages are indexed by name and by name:arch for every architecture
+ * they are installed for, so multiarch installs (e.g. i386 libraries on
+ * amd64 or armhf on arm64) are found without knowing the architecture.
+ * The architecture comes from each stanza of the status file, so neither
+ * dpkg's list of foreign architectures nor the native one is needed.
+ */
+class DpkgStatus
+{
+public:
+    explicit DpkgStatus(const QString &path = QStringLiteral("/var/lib/dpkg/status"));
+
+    /**
+     * Looks @p package up in the index as of the last refresh().
+     * @param package either a plain package name (installed for any
+     *        architecture) or an architecture qualified one (name:arch)
+     */
+    bool isInstalled(const QString &package) const;
+
+    /**
+     * Rebuilds the index if the status file changed since the last parse.
+     * @return true if the index was rebuilt
+     */
+    bool refresh();
+
+    /** Drops the index, the next lookup parses again. */
+    void clear();
+
+private:
+    void parse(const char *data, qint64 size);
+
+    QString m_path;
+    QDateTime m_mtime;
+    qint64 m_size;
+    QSet<QString> m_installed;
+};
+
+#endif // DPKGSTATUS_H
@@ -22,6 +22,8 @@
 
 #include <QDebug>
 
+#include "driverdebug.h"
+
 #warning code copy waaaaaaaaaaaaaaaaaaaaaaaah
 
 Driver::Driver()
@@ -94,11 +96,11 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, QList<Driver> &dr
 {
     argument.beginMap();
     while (!argument.atEnd()) {
-        Driver driver;
+        driverList.append(Driver());
+        Driver &driver = driverList.last();
         argument.beginMapEntry();
         argument >> driver.packageName >> driver;
         argument.endMapEntry();
-        driverList.append(driver);
     }
     argument.endMap();
     return argument;
@@ -106,24 +108,27 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, QList<Driver> &dr
 
 const QDBusArgument &operator>>(const QDBusArgument &argument, Device &device)
 {
+    // QtDBus hands out a{sv} values as QVariant only, so dispatch on the key
+    // and take the value as the type that key is known to carry instead of
+    // probing conversions.
     argument.beginMap();
 
     while (!argument.atEnd()) {
         QString key;
-        QVariant value;
+        QDBusVariant value;
 
         argument.beginMapEntry();
         argument >> key >> value;
 
-        if (key == QLatin1String("modalias")) {
-            device.modalias = value.toString();
+        if (key == QLatin1String("drivers")) {
+            // a{sa{sb}}, still marshalled, read straight into the Drivers.
+            qvariant_cast<QDBusArgument>(value.variant()) >> device.drivers;
+        } else if (key == QLatin1String("modalias")) {
+            device.modalias = value.variant().toString();
         } else if (key == QLatin1String("vendor")) {
-            device.vendor = value.toString();
+            device.vendor = value.variant().toString();
         } else if (key == QLatin1String("model")) {
-            device.model = value.toString();
-        } else if (value.canConvert<QDBusArgument>()) {
-            QDBusArgument arg = value.value<QDBusArgument>();
-            arg >> device.drivers;
+            device.model = value.variant().toString();
         }
 
         argument.endMapEntry();
@@ -135,15 +140,13 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, Device &device)
 
 const QDBusArgument &operator>>(const QDBusArgument &argument, DeviceList &deviceList)
 {
-    qDebug() << Q_FUNC_INFO;
     argument.beginMap();
     while (!argument.atEnd()) {
-        Device device;
+        deviceList.append(Device());
+        Device &device = deviceList.last();
         argument.beginMapEntry();
         argument >> device.id >> device;
         argument.endMapEntry();
-        deviceList.append(device);
-        qDebug() << device;
     }
     argument.endMap();
     return argument;
@@ -152,7 +155,7 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, DeviceList &devic
 QDBusArgument &operator<<(QDBusArgument &argument, const DeviceList &deviceList)
 {
     Q_UNUSED(deviceList);
-    qDebug() << Q_FUNC_INFO << "is noop";
+    qCDebug(NOTIFICATIONHELPER_DRIVER) << Q_FUNC_INFO << "is noop";
     argument.beginMap(QVariant::String, QVariant::Map);
     argument.endMap();
     return argument;
@@ -25,99 +25,267 @@
 
 #include <QDBusConnection>
 #include <QDebug>
-
-#include <QApt/Backend>
+#include <QFileInfo>
+#include <QTimer>
 
 #include <KToolInvocation>
 #include <KConfig>
 #include <KConfigGroup>
 
-DriverEvent::DriverEvent(QObject *parent)
+#include "../coalescer.h"
+#include "driverdebug.h"
+#include "hardwarefingerprint.h"
+#include "ueventsource.h"
+
+// Calls per query; retries back off from the RetryDelay, doubling each time.
+static const int s_maxAttempts = 3;
+
+// Delay before confirming a cached result with DriverManager, keeps the
+// python service out of the login rush.
+static const int s_revalidationDelay = 10 * 60 * 1000;
+
+DriverEvent::DriverEvent(QObject *parent, UEventSource *uevents,
+                         const QString &busRoot, const QString &dpkgStatusPath)
     : Event(parent, "Driver")
+    , m_busRoot(busRoot)
+    , m_dpkgStatusPath(dpkgStatusPath)
+    , m_dpkgStatus(dpkgStatusPath)
+    , m_manager(nullptr)
+    , m_state(Idle)
+    , m_pendingCall(nullptr)
+    , m_retryTimer(new QTimer(this))
+    , m_attempt(0)
+    , m_lastCallDuration(0)
+    , m_callCount(0)
+    , m_failedCallCount(0)
     , m_showNotification(false)
-    , m_aptBackendInitialized(false)
+    , m_notified(false)
+    , m_revalidationTimer(new QTimer(this))
+    , m_hotplugCoalescer(new Coalescer(2000, 10000, this))
 {
     qDBusRegisterMetaType<DeviceList>();
 
+    KConfig cfg("notificationhelper");
+    KConfigGroup driverGroup(&cfg, "Driver");
+    // DriverManager probes all devices, which takes a while on some
+    // systems, but a call not answered within this time is not going to be.
+    m_callTimeout = driverGroup.readEntry("CallTimeout", 120) * 1000;
+    m_retryDelay = driverGroup.readEntry("RetryDelay", 5) * 1000;
+
+    m_revalidationTimer->setSingleShot(true);
+    m_revalidationTimer->setInterval(s_revalidationDelay);
+    connect(m_revalidationTimer, &QTimer::timeout, this, &DriverEvent::queryDevices);
+
+    m_retryTimer->setSingleShot(true);
+    connect(m_retryTimer, &QTimer::timeout, this, &DriverEvent::callDevices);
+
+    connect(this, &Event::hidden, this, &DriverEvent::cancelQuery);
+
+    // Docks and cards bring several devices at once, look at them together.
+    if (!uevents) {
+        uevents = new NetlinkUEventSource(this);
+    }
+    connect(uevents, &UEventSource::deviceAdded, this, &DriverEvent::onDeviceAdded);
+    connect(m_hotplugCoalescer, &Coalescer::triggered, this, [this](const QStringList &modaliases) {
+        foreach (const QString &modalias, modaliases) {
+            m_hotplugModaliases.insert(modalias);
+        }
+        queryHotplugged();
+    });
+
     show();
 }
 
+QString DriverEvent::cacheKey(const QStringList &modaliases) const
+{
+    // The decision depends on the hardware, on what is installed and on
+    // which devices the KCM has processed already.
+    QStringList inputs = modaliases;
+    KConfig driver_manager("kcmdrivermanagerrc");
+    const QMap<QString, QString> processed = KConfigGroup(&driver_manager, "PCI").entryMap();
+    for (auto it = processed.constBegin(); it != processed.constEnd(); ++it) {
+        inputs << it.key() + QLatin1Char('=') + it.value();
+    }
+    const QDateTime dpkgTime = QFileInfo(m_dpkgStatusPath).lastModified();
+    return QString::fromLatin1(HardwareFingerprint::compute(inputs)) + QLatin1Char('-') +
+           QString::number(dpkgTime.toMSecsSinceEpoch());
+}
+
 void DriverEvent::show()
 {
     if (isHidden()) {
         return;
     }
 
-    if (!m_aptBackendInitialized) {
-        m_aptBackend = new QApt::Backend(this);
-        if (!m_aptBackend->init()) {
-            qWarning() << m_aptBackend->initErrorMessage();
-            m_aptBackendInitialized = false;
-        } else {
-            m_aptBackendInitialized = true;
-        }
+    m_notified = false;
+
+    const QStringList modaliases = HardwareFingerprint::modaliases(m_busRoot);
+    m_knownModaliases.clear();
+    foreach (const QString &modalias, modaliases) {
+        m_knownModaliases.insert(modalias);
     }
-    if (m_aptBackendInitialized) {
-        if(m_aptBackend->xapianIndexNeedsUpdate()) {
-            m_aptBackend->updateXapianIndex();
-            connect(m_aptBackend, SIGNAL(xapianUpdateFinished()), SLOT(updateFinished()));
-        } else {
-            updateFinished();
+
+    KConfig cfg("notificationhelper");
+    KConfigGroup driverGroup(&cfg, "Driver");
+    if (driverGroup.readEntry("CacheKey", QString()) == cacheKey(modaliases)) {
+        m_showNotification = driverGroup.readEntry("ShowNotification", false);
+        qCDebug(NOTIFICATIONHELPER_DRIVER) << "hardware and packages unchanged, cached result" << m_showNotification;
+        if (m_showNotification) {
+            showNotification();
         }
+        m_revalidationTimer->start();
+        return;
+    }
+
+    queryDevices();
+}
+
+void DriverEvent::queryDevices()
+{
+    if (isHidden() || m_state != Idle) {
+        return;
+    }
+
+    // Installed state comes from m_dpkgStatus, so no apt cache and in
+    // particular no Xapian index is needed. Keeping the search index
+    // current is left to the tools that actually search.
+    const QStringList modaliases = HardwareFingerprint::modaliases(m_busRoot);
+    foreach (const QString &modalias, modaliases) {
+        m_knownModaliases.insert(modalias);
     }
+    m_queryKey = cacheKey(modaliases);
+    m_queryScope.clear();
+    m_attempt = 0;
+    callDevices();
 }
 
-void DriverEvent::updateFinished()
+void DriverEvent::onDeviceAdded(const QString &devpath, const QString &modalias)
 {
-    if (!m_aptBackend->openXapianIndex()) {
-        qDebug() << "Xapian update could not be opened, probably broken.";
+    Q_UNUSED(devpath);
+    if (isHidden() || m_knownModaliases.contains(modalias)) {
+        return;
+    }
+    m_hotplugCoalescer->add(modalias);
+}
+
+void DriverEvent::queryHotplugged()
+{
+    if (isHidden()) {
+        return;
+    }
+    if (m_state != Idle) {
+        // Retried once the running query is done.
         return;
     }
 
-    m_manager = new OrgKubuntuDriverManagerInterface("org.kubuntu.DriverManager", "/DriverManager", QDBusConnection::sessionBus());
+    foreach (const QString &modalias, m_hotplugModaliases) {
+        if (m_knownModaliases.contains(modalias)) {
+            m_hotplugModaliases.remove(modalias);
+        }
+    }
+    if (m_hotplugModaliases.isEmpty()) {
+        return;
+    }
+
+    // DriverManager only knows about all devices at once, but only the new
+    // ones are looked at and the cached decision for the rest stays as is.
+    qCDebug(NOTIFICATIONHELPER_DRIVER) << "checking hotplugged" << m_hotplugModaliases;
+    m_queryScope = m_hotplugModaliases;
+    m_hotplugModaliases.clear();
+    m_knownModaliases += m_queryScope;
+    m_attempt = 0;
+    callDevices();
+}
 
-    // Force no dbus timeout.
-    // There is exactly one method we use and it must always return. The only
-    // situations where it does not return are those when something is terribly
-    // wrong, however we cannot necessarily detect that with an async connection
-    // either, so instead of asyncyfing the connection, we simply force no timeout.
-    // TODO: this may be practical and equivalent to async connection
-    //       but is really shitty and should be replaced by async connections.
-    //       alas, those have their own unique problems with timer handling in
-    //       python...
-    m_manager->setTimeout(INT_MAX);
+void DriverEvent::callDevices()
+{
+    if (!m_manager) {
+        m_manager = new OrgKubuntuDriverManagerInterface("org.kubuntu.DriverManager", "/DriverManager",
+                                                         QDBusConnection::sessionBus(), this);
+        // A hung service produces a NoReply error after the deadline, which
+        // gets retried like any other failure.
+        m_manager->setTimeout(m_callTimeout);
+    }
 
+    m_state = Querying;
+    ++m_attempt;
+    m_callTime.start();
     QDBusPendingReply<DeviceList> reply = m_manager->devices();
-    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(reply, this);
-    connect(watcher, SIGNAL(finished(QDBusPendingCallWatcher*)),
-            this, SLOT(onDevicesReady(QDBusPendingCallWatcher*)));
+    m_pendingCall = new QDBusPendingCallWatcher(reply, this);
+    connect(m_pendingCall, &QDBusPendingCallWatcher::finished,
+            this, &DriverEvent::onDevicesReady);
+}
+
+void DriverEvent::cancelQuery()
+{
+    // The reply of a cancelled call is simply never looked at.
+    delete m_pendingCall;
+    m_pendingCall = nullptr;
+    m_retryTimer->stop();
+    m_revalidationTimer->stop();
+    m_hotplugModaliases.clear();
+    m_queryScope.clear();
+    m_state = Idle;
 }
 
 void DriverEvent::onDevicesReady(QDBusPendingCallWatcher *call)
 {
+    call->deleteLater();
+    m_pendingCall = nullptr;
+
     QDBusPendingReply<DeviceList> reply = *call;
 
+    m_lastCallDuration = m_callTime.elapsed();
+    ++m_callCount;
     if (reply.isError()) {
-        qDebug() << "got dbus error; abort";
+        ++m_failedCallCount;
+    }
+    qCDebug(NOTIFICATIONHELPER_DRIVER) << "devices() attempt" << m_attempt
+                                       << "duration(ms)" << m_lastCallDuration
+                                       << "calls" << m_callCount << "failed" << m_failedCallCount;
+
+    if (reply.isError()) {
+        qCWarning(NOTIFICATIONHELPER_DRIVER) << "got dbus error" << reply.error().name() << reply.error().message();
+        if (m_attempt < s_maxAttempts) {
+            m_state = RetryWaiting;
+            m_retryTimer->start(m_retryDelay << (m_attempt - 1));
+        } else {
+            m_state = Idle;
+            m_queryScope.clear();
+            queryHotplugged();
+        }
         return;
     }
+    m_state = Idle;
 
     DeviceList devices = reply.value();
-    call->deleteLater(); // deep copy, delete caller
 
-    qDebug() << "data " << devices;
+    qCDebug(NOTIFICATIONHELPER_DRIVER) << "devices" << devices;
 
     KConfig driver_manager("kcmdrivermanagerrc");
     KConfigGroup pciGroup( &driver_manager, "PCI" );
 
-    foreach (Device device, devices) {
+    // Hotplug queries only decide about the new devices.
+    const QSet<QString> scope = m_queryScope;
+    m_queryScope.clear();
+    bool notify = false;
+    m_dpkgStatus.refresh();
+
+    foreach (const Device &device, devices) {
+        m_knownModaliases.insert(device.modalias);
+        if (!scope.isEmpty() && !scope.contains(device.modalias)) {
+            continue;
+        }
+        if (notify) {
+            continue;
+        }
         if (pciGroup.readEntry(device.id) != QLatin1String("true")) {
             // Not seen before, check whether we have recommended drivers.
             for (int i = 0; i < device.drivers.length(); ++i) {
                 // Supposedly Driver is not a pod due to ctor, so it can't
                 // be fully used by QList :'<
                 // Manually iter instead.
-                Driver driver = device.drivers.at(i);
+                const Driver &driver = device.drivers.at(i);
                 // If there is only one driver listed, we consider it an option.
                 // This works around an issue with virtualbox where the one and
                 // only driver is not marked as recommended. However, from
@@ -125,33 +293,68 @@ void DriverEvent::onDevicesReady(QDBusPendingCallWatcher *call)
                 // single-option drivers all the same as even if not considered
                 // recommended they probably should be looked at by the user.
                 if (driver.recommended || device.drivers.length() == 1) {
-                    QApt::Package *package = m_aptBackend->package(driver.packageName);
-                    if (package) {
-                        if (!package->isInstalled()) {
-                            m_showNotification = true;
-                            break;
-                        }
-                    } else {
-                        qDebug() << "package" << driver.packageName << "could not be found";
+                    // DriverManager only offers drivers available in the
+                    // archive, all we need to know is whether it is there.
+                    if (!m_dpkgStatus.isInstalled(driver.packageName)) {
+                        notify = true;
+                        break;
                     }
                 }
             }
         } else {
-            qDebug() << device.id << "has already been processed by the KCM";
+            qCDebug(NOTIFICATIONHELPER_DRIVER) << device.id << "has already been processed by the KCM";
         }
     }
 
-    if (m_showNotification) {
-        QString icon = QString("hwinfo");
-        QString text(i18nc("Notification when additional packages are required for activating proprietary hardware",
-                           "Proprietary drivers might be required to enable additional features"));
-        QStringList actions;
-        actions << i18nc("Launches KDE Control Module to manage drivers", "Manage Drivers");
-        actions << i18nc("Button to dismiss this notification once", "Ignore for now");
-        actions << i18nc("Button to make this notification never show up again",
-                         "Never show again");
-        Event::show(icon, text, actions);
+    if (scope.isEmpty()) {
+        m_showNotification = notify;
+        KConfig cfg("notificationhelper");
+        KConfigGroup driverGroup(&cfg, "Driver");
+        driverGroup.writeEntry("CacheKey", m_queryKey);
+        driverGroup.writeEntry("ShowNotification", m_showNotification);
+    } else if (notify) {
+        // New hardware is worth a new notification. The next login sees a
+        // different fingerprint and does a full check.
+        m_notified = false;
+    }
+
+    if (notify) {
+        showNotification();
+    }
+
+    queryHotplugged();
+    // With a notification up closing it releases.
+    if (m_state == Idle && !isActive()) {
+        releaseCheckState();
+    }
+}
+
+void DriverEvent::dropCheckState()
+{
+    if (m_state != Idle) {
+        return; // Another query started meanwhile.
     }
+    // The package index is rebuilt by the next lookup.
+    m_dpkgStatus.clear();
+}
+
+void DriverEvent::showNotification()
+{
+    // A revalidation must not repeat what the cached result showed already.
+    if (m_notified) {
+        return;
+    }
+    m_notified = true;
+
+    QString icon = QString("hwinfo");
+    QString text(i18nc("Notification when additional packages are required for activating proprietary hardware",
+                       "Proprietary drivers might be required to enable additional features"));
+    QStringList actions;
+    actions << i18nc("Launches KDE Control Module to manage drivers", "Manage Drivers");
+    actions << i18nc("Button to dismiss this notification once", "Ignore for now");
+    actions << i18nc("Button to make this notification never show up again",
+                     "Never show again");
+    Event::show(icon, text, actions);
 }
 
 void DriverEvent::run()
@@ -22,36 +22,95 @@
 #ifndef DRIVEREVENT_H
 #define DRIVEREVENT_H
 
+#include "../dpkgstatus.h"
 #include "../event.h"
 #include "drivermanagerdbustypes.h"
 
-namespace QApt {
-    class Backend;
-}
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSet>
 
+class Coalescer;
 class OrgKubuntuDriverManagerInterface;
 class QDBusPendingCallWatcher;
+class QTimer;
+class UEventSource;
 
 class DriverEvent : public Event
 {
     Q_OBJECT
 public:
-    DriverEvent(QObject* parent);
+    /**
+     * @param uevents source of hotplug events, a netlink source is created
+     *        if none is given
+     * @param busRoot where devices are enumerated, see HardwareFingerprint
+     * @param dpkgStatusPath the dpkg status file, tests use fixtures for
+     *        both
+     */
+    DriverEvent(QObject* parent, UEventSource *uevents = nullptr,
+                const QString &busRoot = QStringLiteral("/sys/bus"),
+                const QString &dpkgStatusPath = QStringLiteral("/var/lib/dpkg/status"));
 
 public Q_SLOTS:
     void show();
 
 private:
-    QApt::Backend *m_aptBackend;
+    friend class DriverEventTest;
+
+    enum QueryState {
+        Idle,
+        Querying,     // devices() call in flight
+        RetryWaiting  // last call failed, backing off before the next one
+    };
+
+    const QString m_busRoot;
+    const QString m_dpkgStatusPath;
+    // Installed state of driver packages, far cheaper than the apt cache.
+    DpkgStatus m_dpkgStatus;
+    // Created on first use and reused for all calls.
     OrgKubuntuDriverManagerInterface *m_manager;
+    QueryState m_state;
+    QDBusPendingCallWatcher *m_pendingCall;
+    QTimer *m_retryTimer;
+    int m_callTimeout;
+    int m_retryDelay;
+    int m_attempt;
+    QElapsedTimer m_callTime;
+    qint64 m_lastCallDuration;
+    int m_callCount;
+    int m_failedCallCount;
     bool m_showNotification;
+    bool m_notified;
     QStringList m_missingPackages;
-    bool m_aptBackendInitialized;
+    // Key of the running query, see cacheKey().
+    QString m_queryKey;
+    QTimer *m_revalidationTimer;
+
+    // Hotplug. Modaliases covered by the cached decision or a query, new
+    // devices waiting for a query and those the running query is about.
+    // An empty scope means the running query covers all devices.
+    QSet<QString> m_knownModaliases;
+    QSet<QString> m_hotplugModaliases;
+    QSet<QString> m_queryScope;
+    Coalescer *m_hotplugCoalescer;
+
+    /**
+     * Identifies everything the notification decision depends on: the
+     * hardware fingerprint of @p modaliases, the dpkg status mtime and the
+     * devices already processed by the KCM. While it is unchanged the last
+     * decision holds.
+     */
+    QString cacheKey(const QStringList &modaliases) const;
+    void showNotification();
+    void dropCheckState() Q_DECL_OVERRIDE;
 
 private Q_SLOTS:
+    void queryDevices();
+    void callDevices();
     void onDevicesReady(QDBusPendingCallWatcher *call);
+    void cancelQuery();
+    void onDeviceAdded(const QString &devpath, const QString &modalias);
+    void queryHotplugged();
     void run();
-    void updateFinished();
 
 };
 
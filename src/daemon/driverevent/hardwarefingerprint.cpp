@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "hardwarefingerprint.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+
+QStringList HardwareFingerprint::modaliases(const QString &busRoot)
+{
+    QStringList aliases;
+    const QDir root(busRoot);
+    foreach (const QString &bus, root.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QDir devices(root.filePath(bus + QLatin1String("/devices")));
+        // Entries are symlinks into /sys/devices.
+        foreach (const QString &device, devices.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            QFile file(devices.filePath(device + QLatin1String("/modalias")));
+            if (!file.open(QFile::ReadOnly)) {
+                continue; // Not every device has one.
+            }
+            const QByteArray alias = file.readLine().trimmed();
+            if (!alias.isEmpty()) {
+                aliases << QString::fromLatin1(alias);
+            }
+        }
+    }
+    aliases.sort();
+    return aliases;
+}
+
+QByteArray HardwareFingerprint::compute(const QStringList &modaliases)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    foreach (const QString &alias, modaliases) {
+        hash.addData(alias.toLatin1());
+        hash.addData("\n", 1);
+    }
+    return hash.result().toHex();
+}
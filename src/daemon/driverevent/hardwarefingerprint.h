@@ -0,0 +1,45 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef HARDWAREFINGERPRINT_H
+#define HARDWAREFINGERPRINT_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+/**
+ * Identifies the present hardware by the modaliases the kernel exports.
+ *
+ * Devices are enumerated under every bus of @p busRoot, which is
+ * /sys/bus in production. The fingerprint is independent of enumeration
+ * order.
+ */
+class HardwareFingerprint
+{
+public:
+    /** @return sorted modaliases of all devices on all buses */
+    static QStringList modaliases(const QString &busRoot = QStringLiteral("/sys/bus"));
+
+    /** @return hex encoded hash of @p modaliases */
+    static QByteArray compute(const QStringList &modaliases);
+};
+
+#endif // HARDWAREFINGERPRINT_H
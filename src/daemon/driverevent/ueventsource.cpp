@@ -0,0 +1,124 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "ueventsource.h"
+
+#include <QSocketNotifier>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/netlink.h>
+
+#include "driverdebug.h"
+
+UEventSource::UEventSource(QObject *parent)
+    : QObject(parent)
+{
+}
+
+UEventSource::~UEventSource()
+{
+}
+
+void UEventSource::processMessage(const char *data, int length)
+{
+    const char *end = data + length;
+    const char *header = data;
+    const char *at = static_cast<const char *>(memchr(header, '@', end - header));
+    if (!at) {
+        return; // Not a kernel message (e.g. udevd's "libudev" ones).
+    }
+
+    const QByteArray action = QByteArray::fromRawData(header, at - header);
+    if (action != "add" && action != "bind") {
+        return;
+    }
+
+    QString devpath;
+    QString modalias;
+    for (const char *property = data + qstrnlen(data, length) + 1; property < end; ) {
+        const int size = qstrnlen(property, end - property);
+        if (size > 9 && memcmp(property, "MODALIAS=", 9) == 0) {
+            modalias = QString::fromLatin1(property + 9, size - 9);
+        } else if (size > 8 && memcmp(property, "DEVPATH=", 8) == 0) {
+            devpath = QString::fromLatin1(property + 8, size - 8);
+        }
+        property += size + 1;
+    }
+
+    if (modalias.isEmpty()) {
+        return;
+    }
+    qCDebug(NOTIFICATIONHELPER_DRIVER) << "uevent" << action << devpath << modalias;
+    emit deviceAdded(devpath, modalias);
+}
+
+NetlinkUEventSource::NetlinkUEventSource(QObject *parent)
+    : UEventSource(parent)
+    , m_fd(socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT))
+    , m_notifier(nullptr)
+{
+    if (m_fd < 0) {
+        qCWarning(NOTIFICATIONHELPER_DRIVER) << "uevent socket failed:" << strerror(errno);
+        return;
+    }
+
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1; // Kernel events, no need for udevd.
+    if (bind(m_fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0) {
+        qCWarning(NOTIFICATIONHELPER_DRIVER) << "uevent bind failed:" << strerror(errno);
+        close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &NetlinkUEventSource::readMessages);
+}
+
+NetlinkUEventSource::~NetlinkUEventSource()
+{
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+void NetlinkUEventSource::readMessages()
+{
+    // Kernel uevents are limited to a few KiB.
+    char buffer[8192];
+    forever {
+        struct sockaddr_nl sender;
+        socklen_t senderLength = sizeof(sender);
+        const ssize_t length = recvfrom(m_fd, buffer, sizeof(buffer), 0,
+                                        reinterpret_cast<struct sockaddr *>(&sender), &senderLength);
+        if (length <= 0) {
+            break; // EAGAIN, nothing left
+        }
+        if (sender.nl_pid != 0) {
+            continue; // Only trust the kernel.
+        }
+        processMessage(buffer, length);
+    }
+}
@@ -0,0 +1,74 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef UEVENTSOURCE_H
+#define UEVENTSOURCE_H
+
+#include <QtCore/QObject>
+
+class QSocketNotifier;
+
+/**
+ * Source of kernel device events.
+ *
+ * Subclasses feed raw uevent messages into processMessage(), tests can do
+ * so with synthetic messages.
+ */
+class UEventSource : public QObject
+{
+    Q_OBJECT
+public:
+    explicit UEventSource(QObject *parent = nullptr);
+    virtual ~UEventSource();
+
+Q_SIGNALS:
+    /**
+     * A device appeared or got a driver bound ("add" and "bind" uevents).
+     * @param devpath sysfs path of the device relative to /sys
+     * @param modalias the device's modalias
+     */
+    void deviceAdded(const QString &devpath, const QString &modalias);
+
+protected:
+    /**
+     * Handles one message in kernel format: an "action@devpath" header
+     * followed by KEY=value properties, all NUL terminated. Messages
+     * without MODALIAS are ignored.
+     */
+    void processMessage(const char *data, int length);
+};
+
+/** Kernel uevents as broadcast on the NETLINK_KOBJECT_UEVENT socket. */
+class NetlinkUEventSource : public UEventSource
+{
+    Q_OBJECT
+public:
+    explicit NetlinkUEventSource(QObject *parent = nullptr);
+    virtual ~NetlinkUEventSource();
+
+private Q_SLOTS:
+    void readMessages();
+
+private:
+    int m_fd;
+    QSocketNotifier *m_notifier;
+};
+
+#endif // UEVENTSOURCE_H
@@ -21,26 +21,36 @@
 
 #include "event.h"
 
+#include <QDebug>
 #include <QIcon>
 #include <QMenu>
 #include <QStringBuilder>
+#include <QTimer>
 
-#include <KActionCollection>
 #include <KConfig>
 #include <KConfigGroup>
 #include <KNotification>
 #include <KStatusNotifierItem>
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 Event::Event(QObject* parent, const QString &name)
         : QObject(parent)
         , m_name(name)
         , m_hidden(false)
         , m_active(false)
+        , m_releasePending(false)
         , m_notifierItem(0)
 {
     m_hiddenCfgString = QString("hide" % m_name % "Notifier");
     m_hidden = readHiddenConfig();
     readNotifyConfig();
+
+    // Check state is kept for as long as the user may act on it.
+    connect(this, &Event::closed, this, &Event::releaseCheckState);
+    connect(this, &Event::hidden, this, &Event::releaseCheckState);
 }
 
 Event::~Event()
@@ -85,6 +95,11 @@ bool Event::isHidden() const
     return m_hidden;
 }
 
+bool Event::isActive() const
+{
+    return m_active;
+}
+
 void Event::show(const QString &icon, const QString &text, const QStringList &actions)
 {
     if (m_active || m_hidden) {
@@ -182,14 +197,47 @@ void Event::hide()
     notifyClosed();
     writeHiddenConfig(true);
     m_hidden = true;
+    emit hidden();
 }
 
 void Event::notifyClosed()
 {
     m_active = false;
+    emit closed();
 }
 
 void Event::reloadConfig()
 {
+    const bool wasHidden = m_hidden;
     m_hidden = readHiddenConfig();
+    if (m_hidden && !wasHidden) {
+        emit hidden();
+    }
+}
+
+void Event::releaseCheckState()
+{
+    if (m_releasePending) {
+        return;
+    }
+    m_releasePending = true;
+    // Not right away, the caller may still be inside a signal of the very
+    // objects going away.
+    QTimer::singleShot(0, this, SLOT(doReleaseCheckState()));
+}
+
+void Event::dropCheckState()
+{
+}
+
+void Event::doReleaseCheckState()
+{
+    m_releasePending = false;
+
+    qDebug() << m_name << "releasing check state";
+    dropCheckState();
+#ifdef __GLIBC__
+    // Freed heap stays with the process otherwise, kded lives all session.
+    malloc_trim(0);
+#endif
 }
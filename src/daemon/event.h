@@ -39,12 +39,37 @@ public:
 
     virtual ~Event();
 
+    /** Whether a notification of this event is currently shown. */
+    bool isActive() const;
+
 public slots:
     bool isHidden() const;
     void show(const QString &icon, const QString &text, const QStringList &actions);
     void run();
     void reloadConfig();
 
+signals:
+    /** Emitted when the user asked to never show this event again. */
+    void hidden();
+    /**
+     * Emitted when the notification went away, acted upon, ignored or
+     * timed out.
+     */
+    void closed();
+
+protected:
+    /**
+     * Schedules dropCheckState() for once control is back in the event
+     * loop. Done whenever the notification is closed or the event hidden;
+     * call it after a check only if that check shows nothing.
+     */
+    void releaseCheckState();
+    /**
+     * Drops state only needed while checking (caches, backends, parsed
+     * data). It must be rebuilt on the next check. Default does nothing.
+     */
+    virtual void dropCheckState();
+
 private slots:
     bool readHiddenConfig();
     void writeHiddenConfig(bool value);
@@ -52,6 +77,7 @@ private slots:
     void ignore();
     void hide();
     void notifyClosed();
+    void doReleaseCheckState();
 
 private:
     QString m_hiddenCfgString;
@@ -60,6 +86,7 @@ private:
     bool m_useKNotify;
     bool m_useTrayIcon;
     bool m_active;
+    bool m_releasePending;
 
     KStatusNotifierItem *m_notifierItem;
 };
@@ -0,0 +1,220 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include "filewatcher.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+FileWatcher *FileWatcher::s_self = nullptr;
+
+static const uint32_t s_watchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO |
+                                    IN_DELETE | IN_MOVED_FROM | IN_ONLYDIR;
+
+FileWatcher::FileWatcher(QObject *parent)
+    : QObject(parent)
+    , m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    , m_notifier(nullptr)
+{
+    if (!s_self) {
+        s_self = this;
+    }
+
+    if (m_fd < 0) {
+        qWarning() << "FileWatcher: inotify_init1 failed:" << strerror(errno);
+        return;
+    }
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &FileWatcher::readEvents);
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (s_self == this) {
+        s_self = nullptr;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+FileWatcher *FileWatcher::self()
+{
+    if (!s_self) {
+        new FileWatcher;
+    }
+    return s_self;
+}
+
+void FileWatcher::addDirectory(const QString &directory)
+{
+    const QString path = QDir::cleanPath(directory);
+    if (m_directories.contains(path)) {
+        return;
+    }
+    m_directories.insert(path);
+    if (!addWatch(path)) {
+        m_pending << path;
+        watchForCreation(path);
+    }
+}
+
+bool FileWatcher::addWatch(const QString &directory)
+{
+    if (m_fd < 0) {
+        return false;
+    }
+    const int wd = inotify_add_watch(m_fd, QFile::encodeName(directory).constData(), s_watchMask);
+    if (wd < 0) {
+        return false;
+    }
+    m_watches.insert(wd, directory);
+    m_watchPaths.insert(directory, wd);
+    return true;
+}
+
+void FileWatcher::watchForCreation(const QString &directory)
+{
+    // Watch the closest existing ancestor, creation of the next path
+    // component shows up as a Created event there.
+    QString parent = directory;
+    do {
+        parent = QFileInfo(parent).path();
+    } while (!addWatch(parent) && parent != QLatin1String("/"));
+}
+
+void FileWatcher::releaseAncestors()
+{
+    // Ancestors are only watched until the pending directories below them
+    // exist, keep the closest watched one of each pending directory.
+    QSet<QString> needed;
+    foreach (const QString &pending, m_pending) {
+        QString parent = pending;
+        do {
+            parent = QFileInfo(parent).path();
+        } while (!m_watchPaths.contains(parent) && parent != QLatin1String("/"));
+        needed.insert(parent);
+    }
+
+    QHash<QString, int>::iterator it = m_watchPaths.begin();
+    while (it != m_watchPaths.end()) {
+        if (m_directories.contains(it.key()) || needed.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        // The IN_IGNORED event this causes is dropped in readEvents().
+        inotify_rm_watch(m_fd, it.value());
+        m_watches.remove(it.value());
+        it = m_watchPaths.erase(it);
+    }
+}
+
+void FileWatcher::readEvents()
+{
+    // Large enough for a burst of events with long names, the kernel queues
+    // whatever does not fit until the next round.
+    alignas(struct inotify_event) char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+
+    bool rescan = false;
+    forever {
+        const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break; // EAGAIN, nothing left
+        }
+
+        for (char *ptr = buffer; ptr < buffer + length; ) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                rescan = true;
+                continue;
+            }
+
+            const QString directory = m_watches.value(event->wd);
+            if (event->mask & IN_IGNORED) {
+                if (directory.isNull()) {
+                    continue; // released ancestor
+                }
+                // Directory went away, pick it up again once recreated.
+                m_watches.remove(event->wd);
+                m_watchPaths.remove(directory);
+                if (m_directories.contains(directory)) {
+                    m_pending << directory;
+                }
+                foreach (const QString &pending, m_pending) {
+                    if (pending == directory || pending.startsWith(directory + QLatin1Char('/'))) {
+                        watchForCreation(pending);
+                    }
+                }
+                continue;
+            }
+            if (directory.isNull() || event->len == 0) {
+                continue;
+            }
+
+            const QString path = directory + QLatin1Char('/') + QFile::decodeName(event->name);
+
+            if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+                // A directory we wait for (or one of its ancestors) appeared.
+                bool resolved = false;
+                foreach (const QString &pending, m_pending) {
+                    if (pending == path && addWatch(pending)) {
+                        m_pending.removeOne(pending);
+                        resolved = true;
+                        rescan = true; // it may already have content
+                    } else if (pending.startsWith(path + QLatin1Char('/'))) {
+                        watchForCreation(pending);
+                        resolved = true;
+                    }
+                }
+                if (resolved) {
+                    releaseAncestors();
+                }
+            }
+
+            if (!m_directories.contains(directory)) {
+                continue; // ancestor of a pending directory
+            }
+
+            if (event->mask & IN_CREATE) {
+                emit changed(path, Created);
+            } else if (event->mask & IN_CLOSE_WRITE) {
+                emit changed(path, ClosedWrite);
+            } else if (event->mask & IN_MOVED_TO) {
+                emit changed(path, MovedIn);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                emit changed(path, Deleted);
+            }
+        }
+    }
+
+    if (rescan) {
+        emit overflowed();
+    }
+}
@@ -0,0 +1,96 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+class QSocketNotifier;
+
+/**
+ * Module-wide file system watcher on a single inotify fd.
+ *
+ * Unlike KDirWatch this reports what happened to which file, so events can
+ * react to exactly the file that changed instead of rescanning entire
+ * directories. It never polls; when idle it is a sleeping fd in the event
+ * loop.
+ */
+class FileWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    enum Change {
+        Created,     ///< file was created (IN_CREATE)
+        ClosedWrite, ///< file opened for writing was closed (IN_CLOSE_WRITE)
+        MovedIn,     ///< file was moved into the directory (IN_MOVED_TO)
+        Deleted      ///< file was deleted or moved away (IN_DELETE, IN_MOVED_FROM)
+    };
+
+    explicit FileWatcher(QObject *parent = nullptr);
+    virtual ~FileWatcher();
+
+    /**
+     * The module-wide instance. The module creates it before any event,
+     * if there is none yet (e.g. in tests) an unparented one is created.
+     */
+    static FileWatcher *self();
+
+    /**
+     * Watches the entries of @p directory. If the directory does not exist
+     * yet the watch is established as soon as it gets created.
+     */
+    void addDirectory(const QString &directory);
+
+Q_SIGNALS:
+    /** @p path is the absolute path of the changed file */
+    void changed(const QString &path, FileWatcher::Change change);
+    /**
+     * The kernel dropped events (or a watch got lost), consumers can not
+     * know what changed and need to rescan everything they watch.
+     */
+    void overflowed();
+
+private Q_SLOTS:
+    void readEvents();
+
+private:
+    bool addWatch(const QString &directory);
+    void watchForCreation(const QString &directory);
+    void releaseAncestors();
+
+    int m_fd;
+    QSocketNotifier *m_notifier;
+    // wd -> directory path without trailing slash, and the reverse.
+    QHash<int, QString> m_watches;
+    QHash<QString, int> m_watchPaths;
+    // Directories asked for through addDirectory(), anything else watched
+    // is an ancestor of a pending one.
+    QSet<QString> m_directories;
+    // Requested directories which do not exist (yet).
+    QStringList m_pending;
+
+    static FileWatcher *s_self;
+};
+
+#endif // FILEWATCHER_H
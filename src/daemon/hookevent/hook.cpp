@@ -65,11 +65,29 @@ QString trimLeft(QString str, int start = 0)
 Hook::Hook(QObject *parent, const QString &hookPath)
     : QObject(parent)
     , m_hookPath(hookPath)
+    , m_id(QFileInfo(hookPath).fileName())
+    , m_bundled(false)
     , m_finished(false)
     , m_locale(QLatin1String(setlocale(LC_ALL, NULL)))
 {
     m_fields = parse(hookPath);
-    loadConfig();
+    m_signature = calculateSignature();
+}
+
+Hook::Hook(QObject *parent, const QString &bundlePath, const QString &id,
+           const QByteArray &data)
+    : QObject(parent)
+    , m_hookPath(bundlePath)
+    , m_id(id)
+    , m_data(data)
+    , m_bundled(true)
+    , m_finished(false)
+    , m_locale(QLatin1String(setlocale(LC_ALL, NULL)))
+{
+    QTextStream stream(m_data);
+    stream.setCodec("UTF-8"); // as required by spec
+    m_fields = parse(stream);
+    m_signature = calculateSignature();
 }
 
 Hook::~Hook()
@@ -85,6 +103,11 @@ void Hook::setLocale(const QString &locale)
     m_locale = locale;
 }
 
+QString Hook::signature() const
+{
+    return m_signature;
+}
+
 QString Hook::getField(const QString &name) const
 {
     // Try to lookup the field with -LOCALE appended, then -LANGUAGE then without
@@ -133,20 +156,17 @@ void Hook::setFinished()
 
 void Hook::loadConfig()
 {
-    QString signature = calculateSignature();
     KConfig config("notificationhelper", KConfig::NoGlobals);
     KConfigGroup group(&config, "updateNotifications");
 
-    m_finished = group.readEntry(signature, false);
+    m_finished = group.readEntry(m_signature, false);
 
     // remain backward compatibile with update-notifier-kde
     // so that after upgrade old notifications are not resurrected
     if (!m_finished) {
         KConfig oldconfig("update-notifier-kderc", KConfig::NoGlobals);
         KConfigGroup oldgroup(&oldconfig, "updateNotifications");
-        QFileInfo fileinfo(m_hookPath);
-        QString oldsignature = fileinfo.fileName();
-        m_finished = oldgroup.readEntry(oldsignature, false);
+        m_finished = oldgroup.readEntry(m_id, false);
         if (m_finished)
             saveConfig(); // copy over to new configuration
     }
@@ -154,11 +174,10 @@ void Hook::loadConfig()
 
 void Hook::saveConfig()
 {
-    QString signature = calculateSignature();
     KConfig config("notificationhelper", KConfig::NoGlobals);
     KConfigGroup group(&config, "updateNotifications");
 
-    group.writeEntry(signature, m_finished);
+    group.writeEntry(m_signature, m_finished);
     group.sync();
 }
 
@@ -166,6 +185,15 @@ QString Hook::calculateSignature() const
 {
     // this is used to uniquely identify a hook so that
     // it is not shown again after it has been executed
+    if (m_bundled) {
+        // The bundle's mtime changes whenever any entry gets added, so for
+        // bundle entries only the entry itself may contribute.
+        QCryptographicHash hash(QCryptographicHash::Md5);
+        hash.addData(m_id.toUtf8());
+        hash.addData(m_data);
+        return hash.result();
+    }
+
     QFile file(m_hookPath);
     QFileInfo fileinfo(m_hookPath);
     QString timestamp = fileinfo.lastModified().toString(Qt::ISODate);
@@ -178,20 +206,91 @@ QString Hook::calculateSignature() const
     return hash.result();
 }
 
-QMap<QString, QString> Hook::parse(const QString &hookPath)
+QList<Hook *> Hook::parseBundle(QObject *parent, const QString &bundlePath)
 {
-    const QMap<QString, QString> emptyMap;
+    QFile file(bundlePath);
+    if (!file.open(QFile::ReadOnly)) {
+        return QList<Hook *>();
+    }
+    // One sequential read for the entire bundle.
+    return parseBundle(parent, bundlePath, file.readAll());
+}
+
+QList<Hook *> Hook::parseBundle(QObject *parent, const QString &bundlePath,
+                                const QByteArray &bundle)
+{
+    QList<Hook *> hooks;
+
+    int pos = bundle.indexOf('\n');
+    if (pos < 0 || bundle.left(pos).trimmed() != "Bundle-Format: 1") {
+        return hooks; // not a bundle we understand
+    }
+    ++pos;
+
+    struct Entry {
+        qint64 offset;
+        qint64 length;
+        QString id;
+    };
+    QList<Entry> index;
+    forever {
+        const int eol = bundle.indexOf('\n', pos);
+        if (eol < 0) {
+            return hooks; // index not terminated
+        }
+        const QByteArray line = bundle.mid(pos, eol - pos).trimmed();
+        pos = eol + 1;
+        if (line.isEmpty()) {
+            break; // end of index
+        }
+        const QList<QByteArray> parts = line.split(' ');
+        bool offsetOk = false;
+        bool lengthOk = false;
+        Entry entry;
+        if (parts.size() == 3) {
+            entry.offset = parts.at(0).toLongLong(&offsetOk);
+            entry.length = parts.at(1).toLongLong(&lengthOk);
+            entry.id = QString::fromUtf8(parts.at(2));
+        }
+        if (!offsetOk || !lengthOk || entry.offset < 0 || entry.length < 0) {
+            return hooks; // malformed index
+        }
+        index << entry;
+    }
+
+    const qint64 payloadSize = bundle.size() - pos;
+    foreach (const Entry &entry, index) {
+        // Never add offset and length, hostile values would overflow.
+        if (entry.offset < 0 || entry.length < 0 || entry.offset > payloadSize ||
+            entry.length > payloadSize - entry.offset) {
+            continue; // truncated bundle, skip what is not there
+        }
+        const QByteArray data = bundle.mid(pos + entry.offset, entry.length);
+        hooks << new Hook(parent, bundlePath, entry.id, data);
+    }
+
+    return hooks;
+}
 
+QMap<QString, QString> Hook::parse(const QString &hookPath)
+{
     QFile file(hookPath);
     if (!file.open(QFile::ReadOnly)) {
-        return emptyMap;
+        return QMap<QString, QString>();
     }
 
-    // See https://wiki.kubuntu.org/InteractiveUpgradeHooks for details on the hook format
-    QMap<QString, QString> fields;
     QTextStream stream(&file);
     stream.setCodec("UTF-8"); // as required by spec
     stream.setAutoDetectUnicode(true); // just in case
+    return parse(stream);
+}
+
+QMap<QString, QString> Hook::parse(QTextStream &stream)
+{
+    const QMap<QString, QString> emptyMap;
+
+    // See https://wiki.kubuntu.org/InteractiveUpgradeHooks for details on the hook format
+    QMap<QString, QString> fields;
 
     QString lastKey;
     QString line;
@@ -28,18 +28,64 @@
 #include <QStringList>
 #include <QMap>
 
+class QTextStream;
+
+/**
+ * A single upgrade hook.
+ *
+ * Construction only reads, parses and fingerprints the hook and is
+ * reentrant, so hooks may be created without parent in a worker thread and
+ * moved to the GUI thread afterwards. Everything else, loadConfig() and
+ * isNotificationRequired() in particular, belongs to the GUI thread.
+ */
 class Hook : public QObject
 {
     Q_OBJECT
 public:
     // FIXME: standard argument order is (stuff, QObject=nullptr)
     Hook(QObject* parent, const QString &hookPath);
+    /**
+     * Constructs a hook from an entry of a hook bundle.
+     * @param bundlePath path of the bundle the entry was read from
+     * @param id identity of the entry within the bundle
+     * @param data the entry in InteractiveUpgradeHooks format
+     */
+    Hook(QObject* parent, const QString &bundlePath, const QString &id,
+         const QByteArray &data);
 
     virtual ~Hook();
 
+    /**
+     * Reads all hooks from the bundle at @p bundlePath in one go.
+     *
+     * A bundle starts with a "Bundle-Format: 1" line followed by one
+     * "<offset> <length> <id>" index line per hook and an empty line.
+     * Offsets are relative to the first byte after that empty line, each
+     * indexed range holds one hook in the regular field format.
+     *
+     * @return list of hooks parented to @p parent, empty if the bundle does
+     *         not exist or is malformed
+     */
+    static QList<Hook *> parseBundle(QObject *parent, const QString &bundlePath);
+    /** Same as above with the content @p bundle already read. */
+    static QList<Hook *> parseBundle(QObject *parent, const QString &bundlePath,
+                                     const QByteArray &bundle);
+
     QString locale();
     void setLocale(const QString &locale);
 
+    /**
+     * Unique identity of this hook (file name, mtime and content), stable
+     * across rescans as long as the hook file does not change.
+     */
+    QString signature() const;
+
+    /**
+     * Reads whether the hook was finished already. Not done on construction
+     * as KConfig is not reentrant.
+     */
+    void loadConfig();
+
 public Q_SLOTS:
     bool isValid() const;
     bool isNotificationRequired() const;
@@ -48,15 +94,22 @@ public Q_SLOTS:
     void setFinished();
 
 private:
+    friend class HookBenchmark;
+
+    static QMap<QString, QString> parse(QTextStream &stream);
+
     QString m_hookPath;
+    QString m_id;
+    QByteArray m_data;
+    bool m_bundled;
     QMap<QString, QString> m_fields;
+    QString m_signature;
     bool m_finished;
     QString m_locale;
 
 private Q_SLOTS:
     QMap<QString, QString> parse(const QString &hookPath);
     QString calculateSignature() const;
-    void loadConfig();
     void saveConfig();
 };
 
@@ -23,21 +23,76 @@
 
 // Qt includes
 #include <QDir>
-
-#include <KDirWatch>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QThread>
+#include <QtConcurrentRun>
 
 // Own includes
+#include "../coalescer.h"
+#include "../filewatcher.h"
 #include "hook.h"
 #include "hookgui.h"
 
+// Optional bundle carrying many hooks in one file, see Hook::parseBundle().
+static const char s_bundlePath[] = "/var/lib/update-notifier/user.bundle";
+
+// Runs in the scan pool. Loads all hooks from @p path and hands the valid
+// ones over to @p target. Whether they require a notification is up to the
+// GUI thread, that involves KConfig and shell commands.
+static QList<Hook *> loadHooks(const QString &path, bool bundle, QThread *target)
+{
+    QList<Hook *> candidates;
+    if (bundle) {
+        candidates = Hook::parseBundle(nullptr, path);
+    } else {
+        candidates << new Hook(nullptr, path);
+    }
+
+    QList<Hook *> hooks;
+    foreach(Hook *hook, candidates) {
+        if (hook->isValid()) {
+            hook->moveToThread(target);
+            hooks << hook;
+        } else {
+            delete hook;
+        }
+    }
+    return hooks;
+}
+
 HookEvent::HookEvent(QObject* parent)
         : Event(parent, "Hook")
         , m_hooks()
+        , m_loaded(false)
         , m_hookGui(0)
+        , m_scanRunning(0)
+        , m_rescanPending(false)
+        , m_runPending(false)
 {
-    auto hooksDirWatch = new KDirWatch(this);
-    hooksDirWatch->addDir("/var/lib/update-notifier/user.d/");
-    connect(hooksDirWatch, &KDirWatch::dirty, this, &HookEvent::show);
+    // Bounded so a full user.d does not monopolize the machine, parsing is
+    // cheap enough that more threads would mostly contend on IO.
+    m_scanPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 4));
+
+    // dpkg drops hooks in bursts during upgrades, scan once it calmed down.
+    auto coalescer = new Coalescer(500, 5000, this);
+    connect(coalescer, &Coalescer::triggered, this, &HookEvent::scan);
+
+    FileWatcher *watcher = FileWatcher::self();
+    watcher->addDirectory("/var/lib/update-notifier/user.d");
+    watcher->addDirectory("/var/lib/update-notifier");
+    connect(watcher, &FileWatcher::changed, coalescer, [coalescer](const QString &path, FileWatcher::Change change) {
+        // A created file is followed by ClosedWrite once its content is
+        // there, do not bother parsing half-written hooks.
+        if (change == FileWatcher::Created) {
+            return;
+        }
+        if (path.startsWith(QLatin1String("/var/lib/update-notifier/user.d/")) ||
+            path == QLatin1String(s_bundlePath)) {
+            coalescer->add(path);
+        }
+    });
+    connect(watcher, &FileWatcher::overflowed, coalescer, [coalescer] { coalescer->add(); });
 
     // Sometimes hooks are for the first boot, so force a check
     show(); // noop when not applicable
@@ -45,28 +100,145 @@ HookEvent::HookEvent(QObject* parent)
 
 HookEvent::~HookEvent()
 {
+    // Queued sources are not worth reading anymore, the running ones only
+    // read files.
+    m_scanPool.clear();
+    m_scanPool.waitForDone();
+    typedef QPair<QString, QFutureWatcher<QList<Hook *> > *> ScanWatcher;
+    foreach(const ScanWatcher &watcher, m_scanWatchers) {
+        // Cleared sources never finish, their result() would block.
+        if (watcher.second->isFinished()) {
+            qDeleteAll(watcher.second->result());
+        }
+    }
 }
 
 void HookEvent::show()
+{
+    scan(QStringList());
+}
+
+void HookEvent::scan(const QStringList &paths)
 {
     if (isHidden()) {
         return;
     }
 
-    qDeleteAll(m_hooks);
+    if (m_scanRunning > 0) {
+        // Scan in flight, its result may already be stale. Go again once
+        // it is done.
+        if (paths.isEmpty()) {
+            m_rescanPaths.clear();
+        } else if (!m_rescanPending || !m_rescanPaths.isEmpty()) {
+            foreach(const QString &path, paths) {
+                m_rescanPaths.insert(path);
+            }
+        }
+        m_rescanPending = true;
+        return;
+    }
+
+    typedef QPair<QString, bool> Source; // path, isBundle
+    QList<Source> sources;
+    // Hooks of vanished sources are dropped in finishScan(), an open dialog
+    // may point at them until then.
+    if (paths.isEmpty()) {
+        m_loaded = true;
+        m_scanRemoved = m_sources.keys();
+
+        QDir hookDir(QLatin1String("/var/lib/update-notifier/user.d/"));
+        QStringList fileList = hookDir.entryList(QDir::Files);
+        foreach(const QString &fileName, fileList) {
+            sources << qMakePair(hookDir.filePath(fileName), false);
+        }
+        sources << qMakePair(QString::fromLatin1(s_bundlePath), true);
+    } else {
+        // Only what changed.
+        foreach(const QString &path, paths) {
+            if (QFile::exists(path)) {
+                sources << qMakePair(path, path == QLatin1String(s_bundlePath));
+            } else {
+                m_scanRemoved << path;
+            }
+        }
+    }
+
+    foreach(const Source &source, sources) {
+        auto watcher = new QFutureWatcher<QList<Hook *> >(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, &HookEvent::onScanProgress);
+        m_scanWatchers << qMakePair(source.first, watcher);
+        ++m_scanRunning;
+        watcher->setFuture(QtConcurrent::run(&m_scanPool, loadHooks,
+                                             source.first, source.second, thread()));
+    }
+
+    if (sources.isEmpty()) {
+        finishScan(); // only deletions
+    }
+}
+
+void HookEvent::onScanProgress()
+{
+    if (--m_scanRunning > 0) {
+        return;
+    }
+    finishScan();
+}
+
+void HookEvent::finishScan()
+{
+    // Only hooks of the scanned sources are news worth a notification.
+    bool found = false;
+    foreach(const QString &path, m_scanRemoved) {
+        qDeleteAll(m_sources.take(path));
+    }
+    m_scanRemoved.clear();
+    typedef QPair<QString, QFutureWatcher<QList<Hook *> > *> ScanWatcher;
+    foreach(const ScanWatcher &watcher, m_scanWatchers) {
+        qDeleteAll(m_sources.take(watcher.first));
+        QList<Hook *> hooks;
+        foreach(Hook *hook, watcher.second->result()) {
+            hook->setParent(this);
+            hook->loadConfig();
+            if (hook->isNotificationRequired()) {
+                hooks << hook;
+            } else {
+                delete hook;
+            }
+        }
+        if (!hooks.isEmpty()) {
+            m_sources.insert(watcher.first, hooks);
+            found = true;
+        }
+        watcher.second->deleteLater();
+    }
+    m_scanWatchers.clear();
+
+    // Merge in source order so the dialog's page order does not depend on
+    // which thread finished first: user.d by name, the bundle last.
     m_hooks.clear();
-    QDir hookDir(QLatin1String("/var/lib/update-notifier/user.d/"));
-    QStringList fileList = hookDir.entryList(QDir::Files);
-    foreach(const QString &fileName, fileList) {
-        Hook *hook = new Hook(this, hookDir.filePath(fileName));
-        if (hook->isValid() && hook->isNotificationRequired()) {
-            m_hooks << hook;
-        } else {
-            hook->deleteLater();
+    for (auto it = m_sources.constBegin(); it != m_sources.constEnd(); ++it) {
+        if (it.key() != QLatin1String(s_bundlePath)) {
+            m_hooks << it.value();
         }
     }
+    m_hooks << m_sources.value(QString::fromLatin1(s_bundlePath));
+
+    // Keep an open dialog pointing at live hooks; pages are diffed by
+    // signature so unchanged hooks stay put.
+    if (m_hookGui) {
+        m_hookGui->refreshDialog(m_hooks);
+    }
 
-    if (!m_hooks.isEmpty()) {
+    if (m_runPending) {
+        // Details were asked for while the hooks were released.
+        if (m_loaded) {
+            m_runPending = false;
+            if (!m_hooks.isEmpty()) {
+                m_hookGui->showDialog(m_hooks);
+            }
+        }
+    } else if (found) {
         QString icon = QLatin1String("help-hint");
         QString text(i18nc("Notification when an upgrade requires the user to do something",
                            "Software upgrade notifications are available"));
@@ -77,13 +249,52 @@ void HookEvent::show()
                          "Never show again");
         Event::show(icon, text, actions);
     }
+
+    if (m_rescanPending) {
+        m_rescanPending = false;
+        const QStringList paths = m_rescanPaths.values();
+        m_rescanPaths.clear();
+        scan(paths);
+        return;
+    }
+
+    if (m_runPending) {
+        // Only part of the hooks was loaded, the dialog needs all of them.
+        show();
+    }
+    // Hooks stay until the notification or dialog closes, later scans diff
+    // against them.
+}
+
+void HookEvent::dropCheckState()
+{
+    // An open dialog points at the hooks, a running scan replaces them.
+    if ((m_hookGui && m_hookGui->hasDialog()) || m_scanRunning > 0) {
+        return;
+    }
+    foreach(const QList<Hook *> &hooks, m_sources) {
+        qDeleteAll(hooks);
+    }
+    m_sources.clear();
+    m_hooks.clear();
+    m_loaded = false;
 }
 
 void HookEvent::run()
 {
     if (!m_hookGui) {
         m_hookGui = new HookGui(this);
+        connect(m_hookGui, &HookGui::dialogClosed, this, [this] { releaseCheckState(); });
+    }
+    if (!m_loaded) {
+        // Released with the notification, the dialog opens once they are
+        // loaded.
+        m_runPending = true;
+        if (m_scanRunning == 0) {
+            show();
+        }
+    } else if (!m_hooks.isEmpty()) {
+        m_hookGui->showDialog(m_hooks);
     }
-    m_hookGui->showDialog(m_hooks);
     Event::run();
 }
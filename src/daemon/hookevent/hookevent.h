@@ -25,10 +25,17 @@
 #include "../event.h"
 
 #include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
 
 class Hook;
 class HookGui;
 
+template <typename T> class QFutureWatcher;
+
 class HookEvent : public Event
 {
     Q_OBJECT
@@ -42,10 +49,40 @@ public slots:
 
 private slots:
     void run();
+    void onScanProgress();
 
 private:
+    /**
+     * Loads the hooks of @p paths (hook files or the bundle), dropping the
+     * ones of paths which no longer exist. Empty @p paths loads everything.
+     */
+    void scan(const QStringList &paths);
+    void finishScan();
+    void dropCheckState() Q_DECL_OVERRIDE;
+
+    // All loaded hooks in source order.
     QList<Hook*> m_hooks;
+    // Source path -> its hooks requiring a notification.
+    QMap<QString, QList<Hook *> > m_sources;
+    // Whether m_sources covers every source, changes only reparse their
+    // own path either way.
+    bool m_loaded;
     HookGui* m_hookGui;
+
+    // Hook files are read, parsed and fingerprinted in parallel; one watcher
+    // per source, in directory order.
+    QThreadPool m_scanPool;
+    QList<QPair<QString, QFutureWatcher<QList<Hook *> > *> > m_scanWatchers;
+    // Watchers not finished yet.
+    int m_scanRunning;
+    // Sources of the running scan which no longer exist.
+    QStringList m_scanRemoved;
+    // Changes arriving during a scan, empty paths for everything.
+    bool m_rescanPending;
+    QSet<QString> m_rescanPaths;
+    // Hooks are released once the notification closes, run() loads them
+    // again.
+    bool m_runPending;
 };
 
 #endif
@@ -37,6 +37,7 @@
 HookGui::HookGui(QObject* parent)
         : QObject(parent)
         , m_dialog(0)
+        , m_signalMapper(0)
 {}
 
 void HookGui::showDialog(QList<Hook*> hooks)
@@ -45,6 +46,22 @@ void HookGui::showDialog(QList<Hook*> hooks)
         createDialog();
     }
     updateDialog(hooks);
+
+    m_dialog->show();
+    KWindowSystem::forceActiveWindow(m_dialog->winId());
+}
+
+void HookGui::refreshDialog(QList<Hook*> hooks)
+{
+    if (!m_dialog) {
+        return;
+    }
+    updateDialog(hooks);
+}
+
+bool HookGui::hasDialog() const
+{
+    return m_dialog;
 }
 
 void HookGui::createDialog()
@@ -53,67 +70,101 @@ void HookGui::createDialog()
     m_dialog->setWindowTitle(i18n("Update Information"));
     m_dialog->setWindowIcon(QIcon::fromTheme("help-hint"));
     m_dialog->setStandardButtons(QDialogButtonBox::Close);
+
+    connect(m_dialog, SIGNAL(finished(int)), this, SLOT(closeDialog()));
+
+    m_signalMapper = new QSignalMapper(m_dialog);
+    connect(m_signalMapper, SIGNAL(mapped(QObject *)),
+            this, SLOT(runCommand(QObject *)));
 }
 
 void HookGui::updateDialog(QList<Hook*> hooks)
 {
-    if (!m_pages.isEmpty()) {
-        m_dialog->hide();
-        // remove old pages
-        foreach (KPageWidgetItem *page, m_pages) {
-            m_dialog->removePage(page);
-        }
-        m_pages.clear();
+    KPageWidgetItem *currentPage = m_dialog->currentPage();
+
+    QHash<QString, Hook *> wanted;
+    foreach (Hook *hook, hooks) {
+        wanted.insert(hook->signature(), hook);
     }
 
-    // Take the parsed upgrade hook(s) and put them in pages
-    QSignalMapper *signalMapper = new QSignalMapper(m_dialog);
-    foreach(const Hook *hook, hooks) {
-        QWidget *content = new QWidget();
-        content->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
-        QVBoxLayout *layout = new QVBoxLayout(content);
-        layout->setMargin(0);
-
-        QString name = hook->getField("Name");
-        KPageWidgetItem *page = new KPageWidgetItem(content, name);
-        page->setIcon(QIcon::fromTheme("help-hint"));
-        page->setProperty("hook", qVariantFromValue((QObject *)hook));
-
-        QString desc = hook->getField("Description");
-        QLabel *descLabel = new QLabel(content);
-        descLabel->setWordWrap(true);
-        descLabel->setText(desc);
-        layout->addWidget(descLabel);
-
-        if (!hook->getField("Command").isEmpty()) {
-#warning fixme do we need this?
-//             layout->addSpacing(2 * KDialog::spacingHint());
-            QString label = hook->getField("ButtonText");
-            if (label.isEmpty())
-                label = i18n("Run this action now");
-            QPushButton *runButton = new QPushButton(QIcon::fromTheme("system-run"), label, content);
-            runButton->setFixedHeight(runButton->sizeHint().height() * 2);
-            runButton->setObjectName("runButton");
-
-            QHBoxLayout *buttonLayout = new QHBoxLayout();
-            buttonLayout->addStretch();
-            buttonLayout->addWidget(runButton);
-            buttonLayout->addStretch();
-            layout->addItem(buttonLayout);
-
-            signalMapper->setMapping(runButton, page);
-            connect(runButton, SIGNAL(clicked()), signalMapper, SLOT(map()));
+    // Drop pages of hooks which are gone, everything else stays in place so
+    // the dialog neither flickers nor loses the user's selection.
+    QMutableHashIterator<QString, KPageWidgetItem *> it(m_pages);
+    while (it.hasNext()) {
+        it.next();
+        if (wanted.contains(it.key())) {
+            continue;
+        }
+        KPageWidgetItem *page = it.value();
+        QPushButton *runButton = page->widget()->findChild<QPushButton *>("runButton");
+        if (runButton) {
+            m_signalMapper->removeMappings(runButton);
+        }
+        if (page == currentPage) {
+            currentPage = 0;
         }
+        m_dialog->removePage(page);
+        it.remove();
+    }
 
+    foreach (Hook *hook, hooks) {
+        const QString signature = hook->signature();
+        KPageWidgetItem *page = m_pages.value(signature);
+        if (page) {
+            // Same hook, new object. The caller owns and recycles Hook
+            // instances on every scan, so repoint the page.
+            page->setProperty("hook", qVariantFromValue((QObject *)hook));
+            continue;
+        }
+        page = createPage(hook);
         m_dialog->addPage(page);
-        m_pages << page;
+        m_pages.insert(signature, page);
     }
 
-    connect(signalMapper, SIGNAL(mapped(QObject *)),
-            this, SLOT(runCommand(QObject *)));
+    if (currentPage) {
+        m_dialog->setCurrentPage(currentPage);
+    }
+}
 
-    m_dialog->show();
-    KWindowSystem::forceActiveWindow(m_dialog->winId());
+KPageWidgetItem *HookGui::createPage(Hook *hook)
+{
+    QWidget *content = new QWidget();
+    content->setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
+    QVBoxLayout *layout = new QVBoxLayout(content);
+    layout->setMargin(0);
+
+    QString name = hook->getField("Name");
+    KPageWidgetItem *page = new KPageWidgetItem(content, name);
+    page->setIcon(QIcon::fromTheme("help-hint"));
+    page->setProperty("hook", qVariantFromValue((QObject *)hook));
+
+    QString desc = hook->getField("Description");
+    QLabel *descLabel = new QLabel(content);
+    descLabel->setWordWrap(true);
+    descLabel->setText(desc);
+    layout->addWidget(descLabel);
+
+    if (!hook->getField("Command").isEmpty()) {
+#warning fixme do we need this?
+//         layout->addSpacing(2 * KDialog::spacingHint());
+        QString label = hook->getField("ButtonText");
+        if (label.isEmpty())
+            label = i18n("Run this action now");
+        QPushButton *runButton = new QPushButton(QIcon::fromTheme("system-run"), label, content);
+        runButton->setFixedHeight(runButton->sizeHint().height() * 2);
+        runButton->setObjectName("runButton");
+
+        QHBoxLayout *buttonLayout = new QHBoxLayout();
+        buttonLayout->addStretch();
+        buttonLayout->addWidget(runButton);
+        buttonLayout->addStretch();
+        layout->addItem(buttonLayout);
+
+        m_signalMapper->setMapping(runButton, page);
+        connect(runButton, SIGNAL(clicked()), m_signalMapper, SLOT(map()));
+    }
+
+    return page;
 }
 
 HookGui::~HookGui()
@@ -137,5 +188,7 @@ void HookGui::closeDialog()
 {
     m_dialog->deleteLater();
     m_dialog = 0;
+    m_signalMapper = 0; // Owned by the dialog.
     m_pages.clear();
+    emit dialogClosed();
 }
@@ -25,8 +25,12 @@
 
 #include "hook.h"
 
+#include <QHash>
+
 class Hook;
 
+class QSignalMapper;
+
 class KPageDialog;
 class KPageWidgetItem;
 
@@ -40,6 +44,19 @@ public:
 
 public slots:
     void showDialog(QList<Hook*> hooks);
+    /**
+     * Brings an already existing dialog in line with @p hooks without
+     * raising it. Noop when no dialog was created yet.
+     */
+    void refreshDialog(QList<Hook*> hooks);
+
+public:
+    /** Whether a dialog referencing hooks exists. */
+    bool hasDialog() const;
+
+signals:
+    /** The dialog was closed, it no longer references any hook. */
+    void dialogClosed();
 
 private slots:
     void createDialog();
@@ -48,8 +65,12 @@ private slots:
     void runCommand(QObject *obj);
 
 private:
+    KPageWidgetItem *createPage(Hook *hook);
+
     KPageDialog* m_dialog;
-    QList<KPageWidgetItem *> m_pages;
+    QSignalMapper *m_signalMapper;
+    // Pages keyed by Hook::signature() so rescans only touch what changed.
+    QHash<QString, KPageWidgetItem *> m_pages;
 };
 
 #endif
@@ -22,19 +22,34 @@
 #include "installevent.h"
 
 // Qt includes
-#include <QtCore/QFile>
 #include <QDebug>
+#include <QLocale>
+#include <QTimer>
 
 // Own includes
+#include "../coalescer.h"
 #include "installgui.h"
 #include "installdbuswatcher.h"
 
 InstallEvent::InstallEvent(QObject *parent)
     : Event(parent, "Install")
-    #warning this isn't localized and makes no sense where it is used
-    , m_applicationName("Install")
+    , m_coalescer(nullptr)
     , m_installGui(0)
 {
+    // Applications tend to ask all at once on session start, answer them
+    // with a single offer.
+    m_coalescer = new Coalescer(1000, 5000, this);
+    connect(m_coalescer, &Coalescer::triggered, this, [this] { processRequests(); });
+    // An offer lasts as long as its notification. Requests held back while
+    // it was shown are offered afresh.
+    connect(this, &Event::closed, this, [this] {
+        m_applications.clear();
+        m_packageList.clear();
+        if (!m_requests.isEmpty()) {
+            QTimer::singleShot(0, this, &InstallEvent::processRequests);
+        }
+    });
+
     // this normally gets called by applications calling it through dbus when they start
     auto installWatcher = new InstallDBusWatcher(this);
     connect(installWatcher,
@@ -42,13 +57,8 @@ InstallEvent::InstallEvent(QObject *parent)
             this,
             [this](const QString &application, const QString &package) { getInfo(application, package); });
 
-    m_webBrowserPackages["flashplugin-installer"] = i18nc("The name of the Adobe Flash plugin", "Flash");
-
-    m_multimediaEncodingPackages["libk3b6-extracodecs"] = i18n("K3b CD Codecs");
-    m_multimediaEncodingPackages["libmp3lame0"] = i18n("MP3 Encoding");
-
-    m_packageMapList.append(m_webBrowserPackages);
-    m_packageMapList.append(m_multimediaEncodingPackages);
+    // Shipped in data/restricted-packages, distributions may add their own.
+    m_catalog.load();
 }
 
 InstallEvent::~InstallEvent()
@@ -64,7 +74,7 @@ void InstallEvent::show()
     QString icon = QString("muondiscover");
     QString text(i18nc("Notification when a package wants to install extra software",
                        "Extra packages can be installed to enhance functionality for %1",
-                       m_applicationName));
+                       QLocale().createSeparatedList(m_applications)));
     QStringList actions;
     actions << i18nc("Opens a dialog with more details", "Details");
     actions << i18nc("Button to dismiss this notification once", "Ignore for now");
@@ -74,34 +84,72 @@ void InstallEvent::show()
     Event::show(icon, text, actions);
 }
 
-void InstallEvent::addPackages(const QMap<QString, QString> &packageList)
+bool InstallEvent::addPackages(const QMap<QString, QString> &packageList)
 {
+    bool missing = false;
     QMap<QString, QString>::const_iterator packageIter = packageList.constBegin();
     while (packageIter != packageList.constEnd()) {
-        // check for .md5sums as .list exists even when the package is removed (but not purged)
-        if (!QFile::exists("/var/lib/dpkg/info/" + packageIter.key() + ".md5sums") &&
-            !QFile::exists("/var/lib/dpkg/info/" + packageIter.key() + ":i386.md5sums") &&
-            !QFile::exists("/var/lib/dpkg/info/" + packageIter.key() + ":amd64.md5sums")) {
+        // Installed for any architecture counts, removed-but-not-purged
+        // (config-files) does not.
+        if (!m_dpkgStatus.isInstalled(packageIter.key())) {
             m_packageList[packageIter.key()] = packageIter.value();
+            missing = true;
         }
         ++packageIter;
     }
+    return missing;
 }
 
 void InstallEvent::getInfo(const QString &application, const QString &package)
 {
-    m_applicationName = application;
-    m_packageList.clear();
+    m_requests[application] << package;
+    m_coalescer->add(application);
+}
 
-    QList<QMap<QString, QString> >::const_iterator packageMapIter = m_packageMapList.constBegin();
-    while (packageMapIter != m_packageMapList.constEnd()) {
-        if ((*packageMapIter).contains(package)) {
-            addPackages(*packageMapIter);
-            break;
+void InstallEvent::processRequests()
+{
+    if (isHidden()) {
+        m_requests.clear();
+        return;
+    }
+    if (isActive()) {
+        // The shown notification can not be updated, keep the requests
+        // until it is gone.
+        return;
+    }
+
+    // One look at the status file for the whole batch.
+    m_dpkgStatus.refresh();
+
+    // Still offered through the tray icon, drop what got installed since.
+    QMap<QString, QString>::iterator pendingIter = m_packageList.begin();
+    while (pendingIter != m_packageList.end()) {
+        if (m_dpkgStatus.isInstalled(pendingIter.key())) {
+            pendingIter = m_packageList.erase(pendingIter);
+        } else {
+            ++pendingIter;
         }
+    }
+    if (m_packageList.isEmpty()) {
+        m_applications.clear();
+    }
 
-        ++packageMapIter;
+    QMap<QString, QSet<QString> >::const_iterator requestIter = m_requests.constBegin();
+    for (; requestIter != m_requests.constEnd(); ++requestIter) {
+        bool missing = false;
+        foreach (const QString &package, requestIter.value()) {
+            const QMap<QString, QString> group = m_catalog.group(package);
+            if (group.isEmpty()) {
+                qDebug() << package << "is not a restricted package";
+                continue;
+            }
+            missing |= addPackages(group);
+        }
+        if (missing && !m_applications.contains(requestIter.key())) {
+            m_applications << requestIter.key();
+        }
     }
+    m_requests.clear();
 
     if (!m_packageList.isEmpty()) {
        show();
@@ -110,6 +158,10 @@ void InstallEvent::getInfo(const QString &application, const QString &package)
 
 void InstallEvent::run()
 {
-    m_installGui = new InstallGui(this, m_applicationName, m_packageList);
+    // One qapt-batch run for everything asked for so far.
+    m_installGui = new InstallGui(this, QLocale().createSeparatedList(m_applications),
+                                  m_packageList);
+    m_applications.clear();
+    m_packageList.clear();
     Event::run();
 }
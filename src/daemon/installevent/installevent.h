@@ -21,11 +21,16 @@
 #ifndef INSTALLEVENT_H
 #define INSTALLEVENT_H
 
+#include "../dpkgstatus.h"
 #include "../event.h"
+#include "restrictedcatalog.h"
 
 // Qt includes
-#include <QtCore/QList>
 #include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+
+class Coalescer;
 
 class InstallGui;
 
@@ -43,14 +48,21 @@ public slots:
 
 private slots:
     void run();
-    void addPackages(const QMap<QString, QString> &packageList);
+    void processRequests();
+    bool addPackages(const QMap<QString, QString> &packageList);
 
 private:
-    QString m_applicationName;
-    QList< QMap<QString, QString> > m_packageMapList;
-    QMap<QString, QString> m_webBrowserPackages;
-    QMap<QString, QString> m_multimediaEncodingPackages;
+    // Application -> requested packages, not looked at yet.
+    QMap<QString, QSet<QString> > m_requests;
+    Coalescer *m_coalescer;
+    // Applications and packages of the pending offer, merged until the
+    // user acts on it.
+    QStringList m_applications;
+    // Packages which may be offered, indexed by package.
+    RestrictedCatalog m_catalog;
     QMap<QString, QString> m_packageList;
+    // Installed packages for all dpkg architectures, kept across requests.
+    DpkgStatus m_dpkgStatus;
     InstallGui *m_installGui;
 };
 
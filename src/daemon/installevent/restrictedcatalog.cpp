@@ -0,0 +1,103 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#include "restrictedcatalog.h"
+
+#include <QDebug>
+#include <QStandardPaths>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+void RestrictedCatalog::load()
+{
+    load(QStandardPaths::locateAll(QStandardPaths::GenericDataLocation,
+                                   QStringLiteral("kubuntu-notification-helper/restricted-packages")),
+         QStringLiteral(RESTRICTED_PACKAGES_PATH));
+}
+
+void RestrictedCatalog::load(const QStringList &paths, const QString &shippedPath)
+{
+    m_groups.clear();
+    m_index.clear();
+    foreach (const QString &path, paths) {
+        loadFile(path, path == shippedPath);
+    }
+    m_groups.squeeze();
+    qDebug() << "restricted packages" << m_index.size() << "in" << m_groups.size() << "groups";
+}
+
+void RestrictedCatalog::loadFile(const QString &path, bool shipped)
+{
+    KConfig config(path, KConfig::SimpleConfig);
+    foreach (const QString &groupName, config.groupList()) {
+        const KConfigGroup group(&config, groupName);
+        const int index = m_groups.size();
+        QMap<QString, QString> packages;
+        foreach (const QString &package, group.keyList()) {
+            if (package.contains(QLatin1Char('/'))) {
+                continue; // package/context, no package name has a slash
+            }
+            if (m_index.contains(package)) {
+                qWarning() << "RestrictedCatalog:" << package << "listed more than once, ignoring"
+                           << groupName << "in" << path;
+                continue;
+            }
+            // A name[xx] entry for the current locale wins, otherwise names
+            // of the shipped catalog are translated through ours, see
+            // Messages.sh.
+            const QString name = group.readEntryUntranslated(package, package);
+            QString localized = group.readEntry(package, name);
+            if (localized == name && shipped) {
+                const QString context = group.readEntryUntranslated(package + QLatin1String("/context"),
+                                                                    QString());
+                localized = context.isEmpty()
+                        ? i18n(name.toUtf8().constData())
+                        : i18nc(context.toUtf8().constData(), name.toUtf8().constData());
+            }
+            packages.insert(package, localized);
+            m_index.insert(package, index);
+        }
+        if (!packages.isEmpty()) {
+            m_groups.append(packages);
+        }
+    }
+}
+
+QMap<QString, QString> RestrictedCatalog::group(const QString &package) const
+{
+    const int index = m_index.value(package, -1);
+    if (index < 0) {
+        return QMap<QString, QString>();
+    }
+    return m_groups.at(index);
+}
+
+int RestrictedCatalog::groupCount() const
+{
+    return m_groups.size();
+}
+
+int RestrictedCatalog::packageCount() const
+{
+    return m_index.size();
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright © 2026 agent <agent@local>                                  *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public License as        *
+ *   published by the Free Software Foundation; either version 2 of        *
+ *   the License or (at your option) version 3 or any later version        *
+ *   accepted by the membership of KDE e.V. (or its successor approved     *
+ *   by the membership of KDE e.V.), which shall act as a proxy            *
+ *   defined in Section 14 of version 3 of the license.                    *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+#ifndef RESTRICTEDCATALOG_H
+#define RESTRICTEDCATALOG_H
+
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+/**
+ * Restricted extras which may be offered through installRestricted().
+ *
+ * The catalog is read from KConfig style files, one group per set of
+ * packages offered together, each entry mapping a package to the name shown
+ * to the user. A "package/context" entry gives translators context for the
+ * name of package, only the shipped catalog is translated through the
+ * notificationhelper catalog. All groups are indexed by package when loading, so finding
+ * the group of a package is a single hash lookup regardless of the size of
+ * the catalog.
+ */
+class RestrictedCatalog
+{
+public:
+    /**
+     * Loads all kubuntu-notification-helper/restricted-packages files
+     * found in the generic data locations.
+     */
+    void load();
+
+    /**
+     * Loads the catalog from @p paths, replacing what was loaded before.
+     * A package listed in more than one group stays in the one read first.
+     * @param shippedPath the one of @p paths whose names get translated
+     *        through i18n(), the others are shown as written unless they
+     *        carry name[xx] entries
+     */
+    void load(const QStringList &paths, const QString &shippedPath = QString());
+
+    /**
+     * @return all packages (package -> display name) offered together with
+     *         @p package, empty if it is not in the catalog
+     */
+    QMap<QString, QString> group(const QString &package) const;
+
+    int groupCount() const;
+    int packageCount() const;
+
+private:
+    void loadFile(const QString &path, bool shipped);
+
+    QVector<QMap<QString, QString> > m_groups;
+    // Package -> index into m_groups.
+    QHash<QString, int> m_index;
+};
+
+#endif // RESTRICTEDCATALOG_H
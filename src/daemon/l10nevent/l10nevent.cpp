@@ -114,6 +114,8 @@ void L10nEvent::showOnLanguageCollectionUpdated()
     m_missingPackages.removeDuplicates();
 
     if (m_missingPackages.isEmpty()) {
+        // Nothing to offer, closing the notification releases otherwise.
+        releaseCheckState();
         return;
     }
 
@@ -152,6 +154,16 @@ bool L10nEvent::checkForMissingPackages(Kubuntu::Language *language)
     return false;
 }
 
+void L10nEvent::dropCheckState()
+{
+    if (!m_languageCollection || !m_languageCollection->isUpdated()) {
+        return; // Another check is underway.
+    }
+    // Holds the whole language and package state, show() builds a new one.
+    delete m_languageCollection;
+    m_languageCollection = nullptr;
+}
+
 QStringList L10nEvent::systemLocaleMatchables() const
 {
     const QString systemLocale = qgetenv("LANG");
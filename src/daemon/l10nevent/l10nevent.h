@@ -46,6 +46,7 @@ private slots:
 private:
     bool checkForMissingPackages(Kubuntu::Language *languages);
     QStringList systemLocaleMatchables() const;
+    void dropCheckState() Q_DECL_OVERRIDE;
 
     Kubuntu::LanguageCollection *m_languageCollection;
     QStringList m_missingPackages;
@@ -31,6 +31,7 @@
 #include <KConfigWatcher>
 
 // Own includes
+#include "filewatcher.h"
 #include "apportevent/apportevent.h"
 #include "hookevent/hookevent.h"
 #include "installevent/installevent.h"
@@ -60,14 +61,18 @@ void NotificationHelperModule::init()
 {
     qDebug();
 
-    const QVector<Event *> events = {
-        new ApportEvent(this),
-        new DriverEvent(this),
-        new HookEvent(this),
-        new InstallEvent(this),
-        new L10nEvent(this),
-        new RebootEvent(this),
-    };
+    // Shared by all events, must exist before any of them.
+    new FileWatcher(this);
+
+    QVector<Event *> events;
+    if (ApportEvent::isAvailable()) {
+        events << new ApportEvent(this);
+    }
+    events << new DriverEvent(this)
+           << new HookEvent(this)
+           << new InstallEvent(this)
+           << new L10nEvent(this)
+           << new RebootEvent(this);
 
     // Todo could hold a watcher in every event really.
     m_configWatcher = KConfigWatcher::create(KSharedConfig::openConfig("notificationhelper"));
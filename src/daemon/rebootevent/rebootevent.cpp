@@ -24,16 +24,27 @@
 #include <QtCore/QFile>
 
 #include <KProcess>
-#include <KDirWatch>
+
+#include "../coalescer.h"
+#include "../filewatcher.h"
 #warning fixme reboot event has no kde version handling anymore
 // #include <kdeversion.h>
 
 RebootEvent::RebootEvent(QObject* parent)
         : Event(parent, "Restart")
 {
-    auto stampDirWatch = new KDirWatch(this);
-    stampDirWatch->addFile("/var/lib/update-notifier/dpkg-run-stamp");
-    connect(stampDirWatch, &KDirWatch::dirty, this, &RebootEvent::show);
+    // The stamp gets touched once per dpkg run, a full-upgrade has plenty.
+    auto coalescer = new Coalescer(2000, 30000, this);
+    connect(coalescer, &Coalescer::triggered, this, [this] { show(); });
+
+    FileWatcher *watcher = FileWatcher::self();
+    watcher->addDirectory("/var/lib/update-notifier");
+    connect(watcher, &FileWatcher::changed, coalescer, [coalescer](const QString &path, FileWatcher::Change change) {
+        if (change != FileWatcher::Deleted && path == QLatin1String("/var/lib/update-notifier/dpkg-run-stamp")) {
+            coalescer->add(path);
+        }
+    });
+    connect(watcher, &FileWatcher::overflowed, coalescer, [coalescer] { coalescer->add(); });
     show(); // noop when nothing to show
 }
 